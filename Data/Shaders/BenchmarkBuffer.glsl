@@ -0,0 +1,43 @@
+-- Compute
+
+#version 450 core
+
+#extension GL_EXT_nonuniform_qualifier : require
+#extension GL_EXT_shader_explicit_arithmetic_types_int64 : require
+#extension GL_EXT_buffer_reference : require
+#extension GL_EXT_buffer_reference2 : require
+#ifdef USE_64_BIT_INDEXING
+#pragma shader_64bit_indexing
+#pragma promote_uint32_indices
+#endif
+
+layout(local_size_x = BLOCK_SIZE, local_size_y = 1, local_size_z = 1) in;
+
+layout(push_constant) uniform PushConstants {
+    uint outputSlot;
+    uint xs, ys, zs, cs;
+};
+
+// Number of entries that do not match the pattern written on the host.
+layout (binding = 0, std430) buffer OutputBuffer {
+    uint numMismatches[];
+};
+
+#include "BufferAccess.glsl"
+
+// Grid-stride loop over the 3D index, so every invocation streams through all members of multiple cells.
+void main() {
+    const uint numEntries3D = xs * ys * zs;
+    const uint numInvocations = gl_NumWorkGroups.x * gl_WorkGroupSize.x;
+    uint localNumMismatches = 0u;
+    for (uint i = gl_GlobalInvocationID.x; i < numEntries3D; i += numInvocations) {
+        for (uint c = 0u; c < cs; c++) {
+            if (!isEntryExpected(readEntry(i, c), i, c)) {
+                localNumMismatches++;
+            }
+        }
+    }
+    if (localNumMismatches != 0u) {
+        atomicAdd(numMismatches[outputSlot], localNumMismatches);
+    }
+}
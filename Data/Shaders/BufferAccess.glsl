@@ -0,0 +1,107 @@
+// Declarations of the input buffers for the different test modes, shared by all kernels reading the fields buffer(s).
+// The dimensions xs, ys, zs and cs are push constants declared by the including shader, so one compiled shader covers
+// all allocation sizes. Only the storage buffer array mode needs MEMBER_COUNT at compile time for its descriptor count.
+// Kernels writing to the fields buffer(s) define FIELDS_ACCESS_QUALIFIER as empty before including this file.
+
+#ifndef FIELDS_ACCESS_QUALIFIER
+#define FIELDS_ACCESS_QUALIFIER readonly
+#endif
+
+#if defined(INPUT_STORAGE_BUFFER)
+layout (binding = 1, std430) FIELDS_ACCESS_QUALIFIER buffer InputBuffer {
+    DATA_TYPE values[];
+};
+#endif
+
+#if defined(INPUT_STORAGE_BUFFER_ARRAY)
+layout (binding = 1, std430) FIELDS_ACCESS_QUALIFIER buffer InputBuffers {
+    DATA_TYPE values[];
+} fieldBuffers[MEMBER_COUNT];
+#endif
+
+#if defined(INPUT_BUFFER_REFERENCE)
+layout (binding = 1, buffer_reference, std430) FIELDS_ACCESS_QUALIFIER buffer InputBuffer {
+    DATA_TYPE values[];
+} fieldBuffers;
+#endif
+
+#if defined(INPUT_BUFFER_REFERENCE_ARRAY)
+layout (buffer_reference, std430, buffer_reference_align = DATA_TYPE_SIZE) buffer InputBuffer {
+    DATA_TYPE value;
+};
+layout (binding = 1) uniform UniformBuffer {
+    uint64_t fieldsBuffer;
+};
+#endif
+
+#define IDXS(x,y,z) ((z)*xs*ys + (y)*xs + (x))
+#ifdef USE_64_BIT_INDEXING
+#define IDXM(x,y,z,c) (uint64_t(c)*uint64_t(xs*ys*zs) + uint64_t(z)*uint64_t(xs*ys) + uint64_t(y)*uint64_t(xs) + uint64_t(x))
+#define IDXL(i,c) (uint64_t(c)*uint64_t(xs*ys*zs) + uint64_t(i))
+#else
+#define IDXM(x,y,z,c) ((c)*xs*ys*zs + (z)*xs*ys + (y)*xs + (x))
+#define IDXL(i,c) ((c)*xs*ys*zs + (i))
+#endif
+
+// Helpers of the benchmark kernels, which read all entries and compare them with the pattern written on the host.
+
+DATA_TYPE readEntry(uint i, uint c) {
+#if defined(INPUT_STORAGE_BUFFER)
+    return values[IDXL(i, c)];
+#elif defined(INPUT_STORAGE_BUFFER_ARRAY)
+    return fieldBuffers[c].values[i];
+#elif defined(INPUT_BUFFER_REFERENCE)
+    return fieldBuffers.values[IDXL(i, c)];
+#elif defined(INPUT_BUFFER_REFERENCE_ARRAY)
+    InputBuffer fb2 = InputBuffer(fieldsBuffer + DATA_TYPE_SIZE * uint64_t(IDXL(i, c)));
+    return fb2.value;
+#endif
+}
+
+// Must match the patterns written by runTest.
+DATA_TYPE expectedEntry(uint i, uint c) {
+    const uint numEntries3D = xs * ys * zs;
+    bool isLastEntry3D = i == numEntries3D - 1u;
+#if defined(INPUT_STORAGE_BUFFER_ARRAY)
+    // All members except for the last one share a buffer where the last entry is zero.
+    if (isLastEntry3D) {
+        return c == cs - 1u ? DATA_TYPE(42) : DATA_TYPE(0);
+    }
+    return DATA_TYPE(7);
+#else
+    if (isLastEntry3D && c == cs - 1u) {
+        return DATA_TYPE(42);
+    }
+#ifdef INDEX_PATTERN
+    return DATA_TYPE(uint64_t(c) * uint64_t(numEntries3D) + uint64_t(i));
+#else
+    return DATA_TYPE(7);
+#endif
+#endif
+}
+
+// Whether an entry read holds the expected value. The float index pattern is converted from the 64-bit index on the
+// host or by the generator shader, which may round differently above 2^24. Like getIsIndexPatternValueValid on the
+// host, these entries are compared in integer space and may differ by one unit in the last place of the index.
+bool isEntryExpected(DATA_TYPE value, uint i, uint c) {
+#if defined(INDEX_PATTERN) && !defined(INPUT_STORAGE_BUFFER_ARRAY)
+    const uint numEntries3D = xs * ys * zs;
+    if (i != numEntries3D - 1u || c != cs - 1u) {
+        // NaN fails the floor comparison; 2^64 and above can't be converted to uint64_t.
+        if (value < 0.0 || value >= 18446744073709551616.0 || floor(value) != value) {
+            return false;
+        }
+        uint64_t entryIdx = uint64_t(c) * uint64_t(numEntries3D) + uint64_t(i);
+        uint64_t valueIdx = uint64_t(value);
+        uint64_t ulp = uint64_t(0);
+        if (entryIdx >= (uint64_t(1) << 24)) {
+            uint entryIdxHigh = uint(entryIdx >> 32);
+            int exponent = entryIdxHigh != 0u ? 32 + findMSB(entryIdxHigh) : findMSB(uint(entryIdx));
+            ulp = uint64_t(1) << (exponent - 23);
+        }
+        uint64_t difference = valueIdx > entryIdx ? valueIdx - entryIdx : entryIdx - valueIdx;
+        return difference <= ulp;
+    }
+#endif
+    return value == expectedEntry(i, c);
+}
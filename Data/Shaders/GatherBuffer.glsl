@@ -0,0 +1,105 @@
+-- Compute
+
+#version 450 core
+
+#extension GL_EXT_nonuniform_qualifier : require
+#extension GL_EXT_shader_explicit_arithmetic_types_int64 : require
+#extension GL_EXT_buffer_reference : require
+#extension GL_EXT_buffer_reference2 : require
+#ifdef USE_64_BIT_INDEXING
+#pragma shader_64bit_indexing
+#pragma promote_uint32_indices
+#endif
+
+layout(local_size_x = BLOCK_SIZE, local_size_y = 1, local_size_z = 1) in;
+
+layout(push_constant) uniform PushConstants {
+    uint outputSlot;
+    uint xs, ys, zs, cs;
+    uint numGathersPerInvocation;
+};
+
+// Number of gathered entries that do not match the pattern written on the host.
+layout (binding = 0, std430) buffer OutputBuffer {
+    uint numMismatches[];
+};
+
+#include "BufferAccess.glsl"
+
+// One round of a bijection of [0, mask], where mask + 1 is a power of two: the xor with a right shift and the
+// multiplication with an odd constant modulo mask + 1 can both be inverted.
+uint permuteBitsRound(uint x, uint mask, uint shift, uint multiplier) {
+    x ^= x >> shift;
+    return (x * multiplier) & mask;
+}
+
+// Pseudo-random permutation of [0, n). The rounds permute [0, 2^k) with the smallest 2^k >= n, and values >= n are
+// mapped again until they fall into [0, n) (cycle walking), which keeps the mapping a bijection of [0, n).
+uint permuteRandom(uint x, uint n) {
+    const uint numBits = uint(findMSB(max(n - 1u, 1u))) + 1u;
+    const uint mask = numBits == 32u ? 0xFFFFFFFFu : (1u << numBits) - 1u;
+    const uint shift = (numBits + 1u) / 2u;
+    do {
+        x = permuteBitsRound(x ^ (0x5BD1E995u & mask), mask, shift, 0x9E3779B1u);
+        x = permuteBitsRound(x, mask, shift, 0x85EBCA6Bu);
+        x = permuteBitsRound(x, mask, shift, 0xC2B2AE35u);
+    } while (x >= n);
+    return x;
+}
+
+// Extracts every third bit of a 3D Morton code.
+uint compactBits3(uint v) {
+    v &= 0x09249249u;
+    v = (v ^ (v >> 2u)) & 0x030C30C3u;
+    v = (v ^ (v >> 4u)) & 0x0300F00Fu;
+    v = (v ^ (v >> 8u)) & 0xFF0000FFu;
+    v = (v ^ (v >> 16u)) & 0x000003FFu;
+    return v;
+}
+
+// Maps gather g in [0, xs * ys * zs * cs) to the 3D index i and the member c of the entry to read. Each pattern is a
+// bijection, so one dispatch reads every entry exactly once. The indices are 32-bit, so the test modes only differ
+// in the address math of readEntry. Except for the random pattern, runs of GATHER_RUN_LENGTH consecutive gathers
+// (e.g., one subgroup) stay in one member and the runs cycle through all members; the host makes sure numEntries3D is
+// a multiple of GATHER_RUN_LENGTH, that GATHER_STRIDE is coprime with it, and that the Morton grid is a cube with a
+// power-of-two side length.
+void getGatherEntry(uint g, out uint i, out uint c) {
+    const uint numEntries3D = xs * ys * zs;
+#if defined(GATHER_PATTERN_RANDOM)
+    uint p = permuteRandom(g, numEntries3D * cs);
+    i = p % numEntries3D;
+    c = p / numEntries3D;
+#else
+    uint run = g / GATHER_RUN_LENGTH;
+    c = run % cs;
+    uint j = (run / cs) * GATHER_RUN_LENGTH + g % GATHER_RUN_LENGTH;
+#if defined(GATHER_PATTERN_STRIDED)
+    i = uint((uint64_t(j) * uint64_t(GATHER_STRIDE)) % uint64_t(numEntries3D));
+#elif defined(GATHER_PATTERN_MORTON)
+    uint x = compactBits3(j);
+    uint y = compactBits3(j >> 1u);
+    uint z = compactBits3(j >> 2u);
+    i = IDXS(x, y, z);
+#endif
+#endif
+}
+
+void main() {
+    const uint numInvocations = gl_NumWorkGroups.x * gl_WorkGroupSize.x;
+    const uint numEntries = xs * ys * zs * cs;
+    uint localNumMismatches = 0u;
+    for (uint k = 0u; k < numGathersPerInvocation; k++) {
+        uint g = k * numInvocations + gl_GlobalInvocationID.x;
+        if (g >= numEntries) {
+            break;
+        }
+        uint i, c;
+        getGatherEntry(g, i, c);
+        if (!isEntryExpected(readEntry(i, c), i, c)) {
+            localNumMismatches++;
+        }
+    }
+    if (localNumMismatches != 0u) {
+        atomicAdd(numMismatches[outputSlot], localNumMismatches);
+    }
+}
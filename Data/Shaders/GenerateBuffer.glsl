@@ -0,0 +1,36 @@
+-- Compute
+
+#version 450 core
+
+#extension GL_EXT_shader_explicit_arithmetic_types_int64 : require
+#extension GL_EXT_buffer_reference : require
+#extension GL_EXT_buffer_reference2 : require
+
+layout(local_size_x = BLOCK_SIZE, local_size_y = 1, local_size_z = 1) in;
+
+layout(push_constant) uniform PushConstants {
+    uint64_t fieldsAddress;
+    uint64_t numEntries;
+};
+
+// Addressed through the raw device address, so the buffer may be larger than the maximum storage buffer range.
+layout (buffer_reference, std430, buffer_reference_align = DATA_TYPE_SIZE) writeonly buffer OutputEntry {
+    DATA_TYPE value;
+};
+
+// Grid-stride loop writing the same pattern as fillFieldsPattern on the host and expected by expectedEntry.
+void main() {
+    const uint64_t numInvocations = uint64_t(gl_NumWorkGroups.x * gl_WorkGroupSize.x);
+    for (uint64_t i = uint64_t(gl_GlobalInvocationID.x); i < numEntries; i += numInvocations) {
+        OutputEntry entry = OutputEntry(fieldsAddress + i * uint64_t(DATA_TYPE_SIZE));
+        if (i == numEntries - uint64_t(1)) {
+            entry.value = DATA_TYPE(42);
+        } else {
+#ifdef INDEX_PATTERN
+            entry.value = DATA_TYPE(i);
+#else
+            entry.value = DATA_TYPE(7);
+#endif
+        }
+    }
+}
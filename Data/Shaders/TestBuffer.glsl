@@ -13,58 +13,26 @@
 
 layout(local_size_x = 1, local_size_y = 1, local_size_z = 1) in;
 
-layout (binding = 0) writeonly buffer OutputBuffer {
-    DATA_TYPE outputValue;
+layout(push_constant) uniform PushConstants {
+    uint outputSlot;
+    uint xs, ys, zs, cs;
 };
 
-#if defined(INPUT_STORAGE_BUFFER)
-layout (binding = 1, std430) readonly buffer InputBuffer {
-    DATA_TYPE values[];
+layout (binding = 0, std430) writeonly buffer OutputBuffer {
+    DATA_TYPE outputValues[];
 };
-#endif
 
-#if defined(INPUT_STORAGE_BUFFER_ARRAY)
-layout (binding = 1, std430) readonly buffer InputBuffers {
-    DATA_TYPE values[];
-} fieldBuffers[MEMBER_COUNT];
-#endif
-
-#if defined(INPUT_BUFFER_REFERENCE)
-layout (binding = 1, buffer_reference, std430) readonly buffer InputBuffer {
-    DATA_TYPE values[];
-} fieldBuffers;
-#endif
-
-#if defined(INPUT_BUFFER_REFERENCE_ARRAY)
-layout (buffer_reference, std430, buffer_reference_align = 4) buffer InputBuffer {
-    DATA_TYPE value;
-};
-layout (binding = 1) uniform UniformBuffer {
-    uint64_t fieldsBuffer;
-};
-#endif
-
-#define IDXS(x,y,z) ((z)*xs*ys + (y)*xs + (x))
-#ifdef USE_64_BIT_INDEXING
-#define IDXM(x,y,z,c) (uint64_t(c)*uint64_t(xs*ys*zs) + uint64_t(z)*uint64_t(xs*ys) + uint64_t(y)*uint64_t(xs) + uint64_t(x))
-#else
-#define IDXM(x,y,z,c) ((c)*xs*ys*zs + (z)*xs*ys + (y)*xs + (x))
-#endif
+#include "BufferAccess.glsl"
 
 void main() {
-    const uint xs = uint(XS);
-    const uint ys = uint(YS);
-    const uint zs = uint(ZS);
-    const uint cs = uint(MEMBER_COUNT);
-
 #if defined(INPUT_STORAGE_BUFFER)
-    outputValue = values[IDXM(xs-1u, ys-1u, zs-1u, cs-1u)];
+    outputValues[outputSlot] = values[IDXM(xs-1u, ys-1u, zs-1u, cs-1u)];
 #elif defined(INPUT_STORAGE_BUFFER_ARRAY)
-    outputValue = fieldBuffers[cs-1].values[IDXS(xs-1u, ys-1u, zs-1u)];
+    outputValues[outputSlot] = fieldBuffers[cs-1].values[IDXS(xs-1u, ys-1u, zs-1u)];
 #elif defined(INPUT_BUFFER_REFERENCE)
-    outputValue = fieldBuffers.values[IDXM(xs-1u, ys-1u, zs-1u, cs-1u)];
+    outputValues[outputSlot] = fieldBuffers.values[IDXM(xs-1u, ys-1u, zs-1u, cs-1u)];
 #elif defined(INPUT_BUFFER_REFERENCE_ARRAY)
     InputBuffer fb2 = InputBuffer(fieldsBuffer + DATA_TYPE_SIZE * uint64_t(IDXM(xs-1u, ys-1u, zs-1u, cs-1u)));
-    outputValue = fb2.value;
+    outputValues[outputSlot] = fb2.value;
 #endif
 }
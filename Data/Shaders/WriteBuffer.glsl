@@ -0,0 +1,92 @@
+-- Compute
+
+#version 450 core
+
+#extension GL_EXT_nonuniform_qualifier : require
+#extension GL_EXT_shader_explicit_arithmetic_types_int64 : require
+#extension GL_EXT_buffer_reference : require
+#extension GL_EXT_buffer_reference2 : require
+#ifdef USE_64_BIT_INDEXING
+#pragma shader_64bit_indexing
+#pragma promote_uint32_indices
+#endif
+
+layout(local_size_x = BLOCK_SIZE, local_size_y = 1, local_size_z = 1) in;
+
+layout(push_constant) uniform PushConstants {
+    uint outputSlot;
+    uint xs, ys, zs, cs;
+    // Number of update dispatches before the verification dispatch.
+    uint numUpdateIterations;
+    // Entries between the targets of two consecutive invocations, coprime with the member size.
+    uint scatterStride;
+};
+
+// Number of entries that do not hold the expected value after all updates.
+layout (binding = 0, std430) buffer OutputBuffer {
+    uint numMismatches[];
+};
+
+#define FIELDS_ACCESS_QUALIFIER
+#include "BufferAccess.glsl"
+
+// The lvalue of an entry for the stores and atomics; the buffer reference array mode needs a local reference first.
+#if defined(INPUT_STORAGE_BUFFER)
+#define DECLARE_ENTRY(name, idx)
+#define ENTRY(name, idx) values[idx]
+#elif defined(INPUT_BUFFER_REFERENCE)
+#define DECLARE_ENTRY(name, idx)
+#define ENTRY(name, idx) fieldBuffers.values[idx]
+#elif defined(INPUT_BUFFER_REFERENCE_ARRAY)
+#define DECLARE_ENTRY(name, idx) InputBuffer name = InputBuffer(fieldsBuffer + DATA_TYPE_SIZE * uint64_t(idx))
+#define ENTRY(name, idx) name.value
+#endif
+
+// Value of an entry after all update dispatches. Depends on the index for stores and maxima, so writes landing at a
+// wrapped-around address are detected.
+DATA_TYPE expectedValue(uint64_t idx) {
+#if defined(WRITE_SCATTERED_STORE)
+    return uint(idx) * 2654435761u + 1u;
+#elif defined(WRITE_ATOMIC_MAX)
+    return uint(idx) + 1u;
+#else
+    return DATA_TYPE(numUpdateIterations);
+#endif
+}
+
+void main() {
+    const uint numEntries3D = xs * ys * zs;
+    const uint numInvocations = gl_NumWorkGroups.x * gl_WorkGroupSize.x;
+#ifdef VERIFY
+    uint localNumMismatches = 0u;
+#endif
+    for (uint i = gl_GlobalInvocationID.x; i < numEntries3D; i += numInvocations) {
+#ifdef VERIFY
+        for (uint c = 0u; c < cs; c++) {
+            DECLARE_ENTRY(entry, IDXL(i, c));
+            if (ENTRY(entry, IDXL(i, c)) != expectedValue(uint64_t(IDXL(i, c)))) {
+                localNumMismatches++;
+            }
+        }
+#else
+        // Scatters the updates within each member; the stride is coprime with the member size, so every entry is
+        // updated exactly once per dispatch.
+        uint scatteredIdx = uint((uint64_t(i) * uint64_t(scatterStride)) % uint64_t(numEntries3D));
+        for (uint c = 0u; c < cs; c++) {
+            DECLARE_ENTRY(entry, IDXL(scatteredIdx, c));
+#if defined(WRITE_SCATTERED_STORE)
+            ENTRY(entry, IDXL(scatteredIdx, c)) = expectedValue(uint64_t(IDXL(scatteredIdx, c)));
+#elif defined(WRITE_ATOMIC_MAX)
+            atomicMax(ENTRY(entry, IDXL(scatteredIdx, c)), expectedValue(uint64_t(IDXL(scatteredIdx, c))));
+#else
+            atomicAdd(ENTRY(entry, IDXL(scatteredIdx, c)), DATA_TYPE(1));
+#endif
+        }
+#endif
+    }
+#ifdef VERIFY
+    if (localNumMismatches != 0u) {
+        atomicAdd(numMismatches[outputSlot], localNumMismatches);
+    }
+#endif
+}
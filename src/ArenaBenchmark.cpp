@@ -0,0 +1,133 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+
+#include <Graphics/Vulkan/Buffers/Buffer.hpp>
+#include <ImGui/Widgets/NumberFormatting.hpp>
+
+#include "Timing.hpp"
+#include "FieldsBuffers.hpp"
+#include "ReadBandwidthMeter.hpp"
+#include "BufferArena.hpp"
+#include "BufferBenchmarkComputePass.hpp"
+#include "ArenaBenchmark.hpp"
+
+static const uint32_t MEMBER_XS = 512;
+static const uint32_t MEMBER_YS = 512;
+static const uint32_t MEMBER_ZS = 64;
+static const size_t MEMBER_ENTRIES = size_t(MEMBER_XS) * size_t(MEMBER_YS) * size_t(MEMBER_ZS);
+
+static void printRow(
+        std::ostream& out, const std::string& name, size_t membersSizeInBytes, double allocationSeconds,
+        size_t allocatedSizeInBytes, size_t numAllocations, const ReadMeasurement& measurement) {
+    out << std::left << std::setw(24) << name << std::right << std::fixed << std::setprecision(2);
+    out << std::setw(12) << (allocationSeconds * 1e3);
+    out << std::setw(14) << sgl::getNiceMemoryString(allocatedSizeInBytes, 2);
+    out << std::setw(14) << sgl::getNiceMemoryString(allocatedSizeInBytes - membersSizeInBytes, 2);
+    out << std::setw(12) << numAllocations;
+    if (measurement.readSeconds > 0.0) {
+        out << std::setw(12) << (double(membersSizeInBytes) / measurement.readSeconds * 1e-9);
+    } else {
+        out << std::setw(12) << "-";
+    }
+    out << std::setw(12) << measurement.numMismatches << std::endl;
+    out.unsetf(std::ios_base::floatfield);
+    out << std::setprecision(6);
+}
+
+void runArenaBenchmark(const TestSettings& testSettings, const TestContext& ctx) {
+    sgl::vk::Device* device = ctx.device;
+    const uint32_t cs = std::max(testSettings.arenaNumMembers, 1u);
+    const size_t memberSizeInBytes = MEMBER_ENTRIES * sizeof(float);
+    const size_t membersSizeInBytes = size_t(cs) * memberSizeInBytes;
+    const VkBufferUsageFlags usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+    ctx.out << std::endl;
+    ctx.out
+            << "Buffer arena benchmark: " << cs << " members of " << sgl::getNiceMemoryString(memberSizeInBytes, 2)
+            << " (" << sgl::getNiceMemoryString(membersSizeInBytes, 2) << ")" << std::endl;
+
+    uint32_t numIterations = std::max(testSettings.benchmarkNumIterations, 1u);
+    ReadBandwidthMeter meter(device, numIterations);
+    auto pass = std::make_shared<BufferBenchmarkComputePass>(
+            meter.getRenderer(), ctx.shaderCache, MEMBER_XS, MEMBER_YS, MEMBER_ZS, cs,
+            testSettings.benchmarkWorkgroupSize);
+    pass->setTestMode(TestMode::STORAGE_BUFFER_ARRAY);
+    pass->setDataType(TestDataType::FLOAT);
+    pass->setOutputBuffer(meter.getOutputBuffer(), 0);
+
+    TestSettings uploadSettings = testSettings;
+    uploadSettings.useStreamingUpload = true;
+
+    // One dedicated allocation per member. VMA would sub-allocate the members from its own blocks, which would make
+    // the baseline an arena, too.
+    ReadMeasurement perMemberRead;
+    double perMemberAllocationSeconds;
+    size_t perMemberAllocatedSizeInBytes, perMemberNumAllocations;
+    {
+        auto startTime = std::chrono::steady_clock::now();
+        BufferArena dedicatedAllocations(device, memberSizeInBytes, cs, usage, true);
+        perMemberAllocationSeconds = getSecondsSince(startTime);
+        perMemberAllocatedSizeInBytes = dedicatedAllocations.getAllocatedSizeInBytes();
+        perMemberNumAllocations = dedicatedAllocations.getNumMemoryBlocks();
+        FieldsBufferTimings timings{};
+        uploadFieldBuffersPattern(uploadSettings, ctx, dedicatedAllocations.getBuffers(), MEMBER_ENTRIES, timings);
+        pass->setFieldBuffers(dedicatedAllocations.getBuffers());
+        perMemberRead = meter.measure(pass.get());
+        pass->setFieldBuffers({});
+    }
+
+    ReadMeasurement arenaRead;
+    double arenaAllocationSeconds;
+    size_t arenaAllocatedSizeInBytes, arenaNumMemoryBlocks;
+    {
+        auto startTime = std::chrono::steady_clock::now();
+        BufferArena arena(device, memberSizeInBytes, cs, usage);
+        arenaAllocationSeconds = getSecondsSince(startTime);
+        arenaAllocatedSizeInBytes = arena.getAllocatedSizeInBytes();
+        arenaNumMemoryBlocks = arena.getNumMemoryBlocks();
+        FieldsBufferTimings timings{};
+        uploadFieldBuffersPattern(uploadSettings, ctx, arena.getBuffers(), MEMBER_ENTRIES, timings);
+        pass->setFieldBuffers(arena.getBuffers());
+        arenaRead = meter.measure(pass.get());
+        pass->setFieldBuffers({});
+    }
+
+    ctx.out
+            << std::left << std::setw(24) << "Variant" << std::right << std::setw(12) << "Alloc [ms]"
+            << std::setw(14) << "Allocated" << std::setw(14) << "Overhead" << std::setw(12) << "Allocations"
+            << std::setw(12) << "GB/s" << std::setw(12) << "Mismatches" << std::endl;
+    printRow(
+            ctx.out, "one buffer per member", membersSizeInBytes, perMemberAllocationSeconds,
+            perMemberAllocatedSizeInBytes, perMemberNumAllocations, perMemberRead);
+    printRow(
+            ctx.out, "buffer arena", membersSizeInBytes, arenaAllocationSeconds,
+            arenaAllocatedSizeInBytes, arenaNumMemoryBlocks, arenaRead);
+}
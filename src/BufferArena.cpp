@@ -0,0 +1,153 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+
+#include <Utils/File/Logfile.hpp>
+#include <Graphics/Vulkan/Utils/Device.hpp>
+
+#include "BufferArena.hpp"
+
+static VkBuffer createVkBuffer(sgl::vk::Device* device, size_t sizeInBytes, VkBufferUsageFlags usage) {
+    VkBufferCreateInfo bufferCreateInfo{};
+    bufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferCreateInfo.size = sizeInBytes;
+    bufferCreateInfo.usage = usage;
+    bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    VkBuffer buffer = VK_NULL_HANDLE;
+    if (vkCreateBuffer(device->getVkDevice(), &bufferCreateInfo, nullptr, &buffer) != VK_SUCCESS) {
+        sgl::Logfile::get()->throwError("Error in BufferArena::BufferArena: Could not create a buffer.");
+    }
+    return buffer;
+}
+
+BufferArena::BufferArena(
+        sgl::vk::Device* device, size_t bufferSizeInBytes, uint32_t numBuffers, VkBufferUsageFlags usage,
+        bool useDedicatedAllocations)
+        : device(device) {
+    if (numBuffers == 0) {
+        sgl::Logfile::get()->throwError("Error in BufferArena::BufferArena: The arena needs at least one buffer.");
+    }
+    // The destructor does not run if the constructor throws, so the buffers created and blocks allocated so far are
+    // released here. The first buffers.size() entries of vkBuffers are owned by the sgl buffers.
+    std::vector<VkBuffer> vkBuffers;
+    try {
+        createBuffers(bufferSizeInBytes, numBuffers, usage, useDedicatedAllocations, vkBuffers);
+    } catch (...) {
+        for (size_t i = buffers.size(); i < vkBuffers.size(); i++) {
+            vkDestroyBuffer(device->getVkDevice(), vkBuffers.at(i), nullptr);
+        }
+        release();
+        throw;
+    }
+}
+
+void BufferArena::createBuffers(
+        size_t bufferSizeInBytes, uint32_t numBuffers, VkBufferUsageFlags usage, bool useDedicatedAllocations,
+        std::vector<VkBuffer>& vkBuffers) {
+    VkDevice vkDevice = device->getVkDevice();
+    vkBuffers.reserve(numBuffers);
+    for (uint32_t i = 0; i < numBuffers; i++) {
+        vkBuffers.push_back(createVkBuffer(device, bufferSizeInBytes, usage));
+    }
+
+    // All buffers have the same creation parameters and thus the same memory requirements.
+    VkMemoryRequirements memoryRequirements{};
+    vkGetBufferMemoryRequirements(vkDevice, vkBuffers.front(), &memoryRequirements);
+    VkDeviceSize alignment = std::max(
+            memoryRequirements.alignment, device->getLimits().minStorageBufferOffsetAlignment);
+    VkDeviceSize stride = (memoryRequirements.size + alignment - 1) / alignment * alignment;
+    VkDeviceSize maxBlockSize = device->getPhysicalDeviceVulkan11Properties().maxMemoryAllocationSize;
+    auto numBuffersPerBlock = uint32_t(std::max(
+            std::min(maxBlockSize / stride, VkDeviceSize(numBuffers)), VkDeviceSize(1)));
+    if (useDedicatedAllocations) {
+        stride = memoryRequirements.size;
+        numBuffersPerBlock = 1;
+    }
+
+    const VkPhysicalDeviceMemoryProperties& deviceMemoryProperties = device->getMemoryProperties();
+    uint32_t memoryTypeIndex = deviceMemoryProperties.memoryTypeCount;
+    for (uint32_t i = 0; i < deviceMemoryProperties.memoryTypeCount; i++) {
+        if ((memoryRequirements.memoryTypeBits & (1u << i)) != 0
+                && (deviceMemoryProperties.memoryTypes[i].propertyFlags & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT) != 0) {
+            memoryTypeIndex = i;
+            break;
+        }
+    }
+    if (memoryTypeIndex == deviceMemoryProperties.memoryTypeCount) {
+        sgl::Logfile::get()->throwError("Error in BufferArena::BufferArena: No device local memory type found.");
+    }
+
+    VkMemoryAllocateFlagsInfo memoryAllocateFlagsInfo{};
+    memoryAllocateFlagsInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO;
+    if ((usage & VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT) != 0) {
+        memoryAllocateFlagsInfo.flags = VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT;
+    }
+    VkMemoryDedicatedAllocateInfo dedicatedAllocateInfo{};
+    dedicatedAllocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_ALLOCATE_INFO;
+    if (useDedicatedAllocations) {
+        memoryAllocateFlagsInfo.pNext = &dedicatedAllocateInfo;
+    }
+    buffers.reserve(numBuffers);
+    for (uint32_t blockStart = 0; blockStart < numBuffers; blockStart += numBuffersPerBlock) {
+        uint32_t numBuffersInBlock = std::min(numBuffersPerBlock, numBuffers - blockStart);
+        VkMemoryAllocateInfo memoryAllocateInfo{};
+        memoryAllocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        memoryAllocateInfo.pNext = &memoryAllocateFlagsInfo;
+        memoryAllocateInfo.allocationSize = stride * numBuffersInBlock;
+        memoryAllocateInfo.memoryTypeIndex = memoryTypeIndex;
+        dedicatedAllocateInfo.buffer = vkBuffers.at(blockStart);
+        VkDeviceMemory memoryBlock = VK_NULL_HANDLE;
+        if (vkAllocateMemory(vkDevice, &memoryAllocateInfo, nullptr, &memoryBlock) != VK_SUCCESS) {
+            sgl::Logfile::get()->throwError("Error in BufferArena::BufferArena: Could not allocate a memory block.");
+        }
+        memoryBlocks.push_back(memoryBlock);
+        allocatedSizeInBytes += size_t(memoryAllocateInfo.allocationSize);
+        for (uint32_t i = 0; i < numBuffersInBlock; i++) {
+            VkBuffer vkBuffer = vkBuffers.at(blockStart + i);
+            if (vkBindBufferMemory(vkDevice, vkBuffer, memoryBlock, stride * i) != VK_SUCCESS) {
+                sgl::Logfile::get()->throwError("Error in BufferArena::BufferArena: Could not bind a buffer.");
+            }
+            // No device memory is passed, so the sgl buffer only destroys its VkBuffer and the arena frees the block.
+            buffers.push_back(std::make_shared<sgl::vk::Buffer>(
+                    device, bufferSizeInBytes, vkBuffer, VK_NULL_HANDLE, usage));
+        }
+    }
+}
+
+BufferArena::~BufferArena() {
+    release();
+}
+
+void BufferArena::release() {
+    buffers.clear();
+    for (VkDeviceMemory memoryBlock : memoryBlocks) {
+        vkFreeMemory(device->getVkDevice(), memoryBlock, nullptr);
+    }
+    memoryBlocks.clear();
+}
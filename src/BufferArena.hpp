@@ -0,0 +1,71 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef BUFFERTEST64_BUFFERARENA_HPP
+#define BUFFERTEST64_BUFFERARENA_HPP
+
+#include <vector>
+
+#include <Graphics/Vulkan/Buffers/Buffer.hpp>
+
+/**
+ * Sub-allocates many equally sized device-local buffers from as few VkDeviceMemory blocks as possible, instead of one
+ * allocation per buffer counting against maxMemoryAllocationCount. Each buffer is bound at an offset aligned to the
+ * buffer memory requirements and minStorageBufferOffsetAlignment; a block holds as many buffers as fit into
+ * maxMemoryAllocationSize. The arena owns the memory blocks, so it needs to outlive all uses of its buffers. At least
+ * one buffer is needed. With useDedicatedAllocations, each buffer instead gets a dedicated allocation of exactly its
+ * memory requirements (VkMemoryDedicatedAllocateInfo), which is the baseline the sub-allocation is compared with.
+ */
+class BufferArena {
+public:
+    BufferArena(
+            sgl::vk::Device* device, size_t bufferSizeInBytes, uint32_t numBuffers, VkBufferUsageFlags usage,
+            bool useDedicatedAllocations = false);
+    ~BufferArena();
+    BufferArena(const BufferArena&) = delete;
+    BufferArena& operator=(const BufferArena&) = delete;
+
+    [[nodiscard]] inline const std::vector<sgl::vk::BufferPtr>& getBuffers() const { return buffers; }
+    [[nodiscard]] inline size_t getNumMemoryBlocks() const { return memoryBlocks.size(); }
+    /// Size of all memory blocks, including alignment padding.
+    [[nodiscard]] inline size_t getAllocatedSizeInBytes() const { return allocatedSizeInBytes; }
+
+private:
+    /// Appends the created VkBuffers to vkBuffers before wrapping them, so the constructor can clean up on errors.
+    void createBuffers(
+            size_t bufferSizeInBytes, uint32_t numBuffers, VkBufferUsageFlags usage, bool useDedicatedAllocations,
+            std::vector<VkBuffer>& vkBuffers);
+    void release();
+
+    sgl::vk::Device* device;
+    std::vector<VkDeviceMemory> memoryBlocks;
+    std::vector<sgl::vk::BufferPtr> buffers;
+    size_t allocatedSizeInBytes = 0;
+};
+
+#endif //BUFFERTEST64_BUFFERARENA_HPP
@@ -0,0 +1,64 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+
+#include <Math/Math.hpp>
+#include <Graphics/Vulkan/Utils/Device.hpp>
+#include <Graphics/Vulkan/Render/Renderer.hpp>
+
+#include "ShaderCache.hpp"
+#include "BufferBenchmarkComputePass.hpp"
+
+BufferBenchmarkComputePass::BufferBenchmarkComputePass(
+        sgl::vk::Renderer* renderer, ShaderCache* shaderCache, uint32_t xs, uint32_t ys, uint32_t zs, uint32_t cs,
+        uint32_t workgroupSize)
+        : BufferTestComputePass(renderer, shaderCache, xs, ys, zs, cs), workgroupSize(workgroupSize) {
+}
+
+void BufferBenchmarkComputePass::loadShader() {
+    std::map<std::string, std::string> preprocessorDefines;
+    std::vector<std::string> extensions;
+    addPreprocessorDefines(preprocessorDefines, extensions);
+    setExtensionsDefine(preprocessorDefines, extensions);
+    preprocessorDefines.insert(std::make_pair("BLOCK_SIZE", std::to_string(workgroupSize)));
+    if (dataType == TestDataType::FLOAT) {
+        preprocessorDefines.insert(std::make_pair("INDEX_PATTERN", ""));
+    }
+    shaderStages = shaderCache->getShaderStages("BenchmarkBuffer.Compute", preprocessorDefines);
+}
+
+void BufferBenchmarkComputePass::_render() {
+    updateUniformBuffer();
+    pushConstants();
+    // Enough work groups to saturate the device; the grid-stride loop covers the remaining entries.
+    uint32_t numEntries3D = xs * ys * zs;
+    uint32_t numWorkgroups = sgl::uiceil(numEntries3D, workgroupSize);
+    numWorkgroups = std::min(numWorkgroups, std::min(device->getLimits().maxComputeWorkGroupCount[0], 65535u));
+    renderer->dispatch(computeData, numWorkgroups, 1, 1);
+}
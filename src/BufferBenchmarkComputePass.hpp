@@ -0,0 +1,53 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef BUFFERTEST64_BUFFERBENCHMARKCOMPUTEPASS_HPP
+#define BUFFERTEST64_BUFFERBENCHMARKCOMPUTEPASS_HPP
+
+#include "BufferTestComputePass.hpp"
+
+/**
+ * Streams every entry of the fields buffer(s) through a grid-stride kernel using the access path of the test mode.
+ * The uint32_t output slot receives the number of entries not matching the pattern written on the host, so it needs
+ * to be cleared before the first dispatch.
+ */
+class BufferBenchmarkComputePass : public BufferTestComputePass {
+public:
+    BufferBenchmarkComputePass(
+            sgl::vk::Renderer* renderer, ShaderCache* shaderCache, uint32_t xs, uint32_t ys, uint32_t zs, uint32_t cs,
+            uint32_t workgroupSize);
+
+protected:
+    void loadShader() override;
+    void _render() override;
+
+private:
+    uint32_t workgroupSize;
+};
+
+#endif //BUFFERTEST64_BUFFERBENCHMARKCOMPUTEPASS_HPP
@@ -0,0 +1,120 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <numeric>
+
+#include <Utils/File/Logfile.hpp>
+#include <Graphics/Vulkan/Utils/Device.hpp>
+#include <Graphics/Vulkan/Render/Renderer.hpp>
+
+#include "ShaderCache.hpp"
+#include "BufferGatherComputePass.hpp"
+
+// Minimum number of entries between two consecutive strided gathers; raised to the next stride coprime with the
+// member size, so the strided index stream is a permutation of the member.
+static const uint32_t GATHER_STRIDE = 4099;
+static const uint32_t GATHER_RUN_LENGTH = 32;
+
+BufferGatherComputePass::BufferGatherComputePass(
+        sgl::vk::Renderer* renderer, ShaderCache* shaderCache, uint32_t xs, uint32_t ys, uint32_t zs, uint32_t cs,
+        uint32_t workgroupSize)
+        : BufferTestComputePass(renderer, shaderCache, xs, ys, zs, cs), workgroupSize(workgroupSize) {
+    // The index streams are bijections of [0, numEntries), which the shader evaluates with 32-bit indices.
+    const uint64_t numEntries3D = uint64_t(xs) * uint64_t(ys) * uint64_t(zs);
+    numEntries = numEntries3D * uint64_t(cs);
+    if (numEntries == 0 || numEntries > uint64_t(UINT32_MAX) || numEntries3D % GATHER_RUN_LENGTH != 0) {
+        sgl::Logfile::get()->throwError(
+                "Error in BufferGatherComputePass::BufferGatherComputePass: The gather patterns need fewer than 2^32 "
+                "entries and a member size that is a multiple of " + std::to_string(GATHER_RUN_LENGTH) + ".");
+    }
+    gatherStride = GATHER_STRIDE;
+    while (std::gcd(uint64_t(gatherStride), numEntries3D) != 1) {
+        gatherStride++;
+    }
+
+    // Enough gathers per invocation that one dispatch covers every entry; the shader skips the excess gathers.
+    const uint64_t numInvocations = uint64_t(getNumWorkgroups()) * uint64_t(workgroupSize);
+    numGathersPerInvocation = uint32_t((numEntries + numInvocations - 1) / numInvocations);
+    if (numInvocations * uint64_t(numGathersPerInvocation) < numEntries
+            || numInvocations * uint64_t(numGathersPerInvocation) > uint64_t(UINT32_MAX) + 1) {
+        sgl::Logfile::get()->throwError(
+                "Error in BufferGatherComputePass::BufferGatherComputePass: The dispatch does not cover all entries.");
+    }
+}
+
+void BufferGatherComputePass::setGatherPattern(GatherPattern _gatherPattern) {
+    bool isPowerOfTwo = (xs & (xs - 1)) == 0;
+    if (_gatherPattern == GatherPattern::MORTON && (xs != ys || xs != zs || !isPowerOfTwo)) {
+        // Otherwise, the Morton codes of [0, numEntries3D) would not cover the grid.
+        sgl::Logfile::get()->throwError(
+                "Error in BufferGatherComputePass::setGatherPattern: The Morton pattern needs a cube grid with a "
+                "power-of-two side length.");
+    }
+    gatherPattern = _gatherPattern;
+    setShaderDirty();
+}
+
+uint32_t BufferGatherComputePass::getNumWorkgroups() const {
+    return std::min(device->getLimits().maxComputeWorkGroupCount[0], 65535u);
+}
+
+uint64_t BufferGatherComputePass::getNumGathers() const {
+    return numEntries;
+}
+
+void BufferGatherComputePass::loadShader() {
+    std::map<std::string, std::string> preprocessorDefines;
+    std::vector<std::string> extensions;
+    addPreprocessorDefines(preprocessorDefines, extensions);
+    setExtensionsDefine(preprocessorDefines, extensions);
+    preprocessorDefines.insert(std::make_pair("BLOCK_SIZE", std::to_string(workgroupSize)));
+    if (dataType == TestDataType::FLOAT) {
+        preprocessorDefines.insert(std::make_pair("INDEX_PATTERN", ""));
+    }
+    if (gatherPattern == GatherPattern::RANDOM) {
+        preprocessorDefines.insert(std::make_pair("GATHER_PATTERN_RANDOM", ""));
+    } else if (gatherPattern == GatherPattern::STRIDED) {
+        preprocessorDefines.insert(std::make_pair("GATHER_PATTERN_STRIDED", ""));
+    } else if (gatherPattern == GatherPattern::MORTON) {
+        preprocessorDefines.insert(std::make_pair("GATHER_PATTERN_MORTON", ""));
+    }
+    preprocessorDefines.insert(std::make_pair("GATHER_STRIDE", std::to_string(gatherStride) + "u"));
+    preprocessorDefines.insert(std::make_pair("GATHER_RUN_LENGTH", std::to_string(GATHER_RUN_LENGTH) + "u"));
+    shaderStages = shaderCache->getShaderStages("GatherBuffer.Compute", preprocessorDefines);
+}
+
+void BufferGatherComputePass::_render() {
+    updateUniformBuffer();
+    pushConstants();
+    // Appended to the push constants of the base class.
+    renderer->pushConstants(
+            computeData->getComputePipeline(), VK_SHADER_STAGE_COMPUTE_BIT, 5 * sizeof(uint32_t),
+            numGathersPerInvocation);
+    renderer->dispatch(computeData, getNumWorkgroups(), 1, 1);
+}
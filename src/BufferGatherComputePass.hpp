@@ -0,0 +1,62 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef BUFFERTEST64_BUFFERGATHERCOMPUTEPASS_HPP
+#define BUFFERTEST64_BUFFERGATHERCOMPUTEPASS_HPP
+
+#include "BufferTestComputePass.hpp"
+
+/**
+ * Gathers entries of the fields buffer(s) at the indices of a generated index stream spanning all members and counts
+ * the entries not matching the pattern written on the host in the output slot. Used for measuring the overhead of the
+ * address math of the test modes under cache-hostile access patterns.
+ */
+class BufferGatherComputePass : public BufferTestComputePass {
+public:
+    BufferGatherComputePass(
+            sgl::vk::Renderer* renderer, ShaderCache* shaderCache, uint32_t xs, uint32_t ys, uint32_t zs, uint32_t cs,
+            uint32_t workgroupSize);
+    void setGatherPattern(GatherPattern _gatherPattern);
+    /// Returns the number of entries gathered by one dispatch; every entry of the buffer(s) is gathered exactly once.
+    [[nodiscard]] uint64_t getNumGathers() const;
+
+protected:
+    void loadShader() override;
+    void _render() override;
+
+private:
+    uint32_t getNumWorkgroups() const;
+
+    uint32_t workgroupSize;
+    GatherPattern gatherPattern = GatherPattern::RANDOM;
+    uint64_t numEntries = 0;
+    uint32_t gatherStride = 0;
+    uint32_t numGathersPerInvocation = 0;
+};
+
+#endif //BUFFERTEST64_BUFFERGATHERCOMPUTEPASS_HPP
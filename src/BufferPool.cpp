@@ -0,0 +1,72 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+
+#include "BufferPool.hpp"
+
+void BufferPool::beginTestCase(size_t sizeInBytes, TestDataType dataType, bool useHostAllocation) {
+    if (sizeInBytes != currentSizeInBytes || dataType != currentDataType) {
+        clear();
+        currentSizeInBytes = sizeInBytes;
+        currentDataType = dataType;
+    }
+    // The field buffers of the storage buffer array mode are always device-local and used by both allocation kinds.
+    entries.erase(std::remove_if(entries.begin(), entries.end(), [&](const Entry& entry) {
+        return entry.key.contents == BufferContents::FIELDS && entry.key.useHostAllocation != useHostAllocation;
+    }), entries.end());
+}
+
+bool BufferPool::find(const BufferPoolKey& key, std::vector<sgl::vk::BufferPtr>& buffers) {
+    for (const Entry& entry : entries) {
+        if (entry.key == key) {
+            buffers = entry.buffers;
+            numHits++;
+            savedSeconds += entry.timings.allocationSeconds + entry.timings.fillSeconds + entry.timings.uploadSeconds;
+            return true;
+        }
+    }
+    numMisses++;
+    return false;
+}
+
+void BufferPool::insert(
+        const BufferPoolKey& key, const std::vector<sgl::vk::BufferPtr>& buffers,
+        const FieldsBufferTimings& timings) {
+    entries.push_back({ key, buffers, timings });
+}
+
+void BufferPool::clear() {
+    entries.clear();
+}
+
+void BufferPool::printStatistics(std::ostream& out) const {
+    out
+            << "Buffer pool: " << numHits << " hits, " << numMisses << " misses, "
+            << (savedSeconds * 1e3) << "ms of allocation, fill and upload saved" << std::endl;
+}
@@ -0,0 +1,92 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef BUFFERTEST64_BUFFERPOOL_HPP
+#define BUFFERTEST64_BUFFERPOOL_HPP
+
+#include <ostream>
+#include <vector>
+
+#include <Graphics/Vulkan/Buffers/Buffer.hpp>
+
+#include "TestTypes.hpp"
+#include "FieldsBuffers.hpp"
+
+enum class BufferContents {
+    FIELDS, // Fields buffer of all modes not using a buffer array.
+    FIELD_BUFFERS // Members of the storage buffer array mode.
+};
+
+struct BufferPoolKey {
+    BufferContents contents;
+    size_t sizeInBytes;
+    TestDataType dataType;
+    bool useHostAllocation;
+
+    bool operator==(const BufferPoolKey& other) const {
+        return contents == other.contents && sizeInBytes == other.sizeInBytes && dataType == other.dataType
+                && useHostAllocation == other.useHostAllocation;
+    }
+};
+
+/**
+ * Keeps filled fields buffers alive across test cases, so test cases reading the same contents only fill and upload
+ * them once. The buffers are only read by the test passes, so they can be shared. All pooled buffers are released as
+ * soon as a test case with a different allocation size or data type begins, so at most the buffers of one allocation
+ * size are resident at a time. Likewise, a fields buffer of the other allocation kind (device or host) is released when
+ * the allocation kind changes, so a device-local fields buffer does not stay resident next to its host counterpart.
+ */
+class BufferPool {
+public:
+    /**
+     * Releases all pooled buffers if the allocation size or data type differs from the last test case, and the
+     * entries of the other allocation kind if only the allocation kind differs.
+     */
+    void beginTestCase(size_t sizeInBytes, TestDataType dataType, bool useHostAllocation);
+    /// Returns true and sets buffers if the pool contains buffers with this key.
+    bool find(const BufferPoolKey& key, std::vector<sgl::vk::BufferPtr>& buffers);
+    /// Adds filled buffers; timings are the times saved by each later hit.
+    void insert(const BufferPoolKey& key, const std::vector<sgl::vk::BufferPtr>& buffers,
+                const FieldsBufferTimings& timings);
+    void clear();
+    void printStatistics(std::ostream& out) const;
+
+private:
+    struct Entry {
+        BufferPoolKey key;
+        std::vector<sgl::vk::BufferPtr> buffers;
+        FieldsBufferTimings timings;
+    };
+    std::vector<Entry> entries;
+    size_t currentSizeInBytes = 0;
+    TestDataType currentDataType = TestDataType::FLOAT;
+    size_t numHits = 0, numMisses = 0;
+    double savedSeconds = 0.0;
+};
+
+#endif //BUFFERTEST64_BUFFERPOOL_HPP
@@ -0,0 +1,211 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <Graphics/Vulkan/Render/Renderer.hpp>
+#include <Graphics/Vulkan/Render/ComputePipeline.hpp>
+
+#include "ShaderCache.hpp"
+#include "BufferTestComputePass.hpp"
+
+BufferTestComputePass::BufferTestComputePass(
+        sgl::vk::Renderer* renderer, ShaderCache* shaderCache, uint32_t xs, uint32_t ys, uint32_t zs, uint32_t cs)
+        : ComputePass(renderer), shaderCache(shaderCache), xs(xs), ys(ys), zs(zs), cs(cs) {
+    uniformBuffer = std::make_shared<sgl::vk::Buffer>(
+            device, sizeof(uint64_t),
+            VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+            VMA_MEMORY_USAGE_GPU_ONLY);
+}
+
+void BufferTestComputePass::setTestMode(TestMode _testMode) {
+    testMode = _testMode;
+    setShaderDirty();
+}
+
+void BufferTestComputePass::setDataType(TestDataType _dataType) {
+    dataType = _dataType;
+    setShaderDirty();
+}
+
+void BufferTestComputePass::setOutputBuffer(const sgl::vk::BufferPtr& _outputBuffer, uint32_t _outputSlot) {
+    outputBuffer = _outputBuffer;
+    outputSlot = _outputSlot;
+    setDataDirty();
+}
+
+void BufferTestComputePass::setDimensions(uint32_t _xs, uint32_t _ys, uint32_t _zs, uint32_t _cs) {
+    if (testMode == TestMode::STORAGE_BUFFER_ARRAY && _cs != cs) {
+        setShaderDirty();
+    }
+    xs = _xs;
+    ys = _ys;
+    zs = _zs;
+    cs = _cs;
+}
+
+void BufferTestComputePass::setFieldsBuffer(const sgl::vk::BufferPtr& _fieldsBuffer) {
+    fieldsBuffer = _fieldsBuffer;
+    setDataDirty();
+}
+
+void BufferTestComputePass::setFieldBuffers(const std::vector<sgl::vk::BufferPtr>& _fieldBuffers) {
+    fieldBuffers = _fieldBuffers;
+    setDataDirty();
+}
+
+void BufferTestComputePass::setFieldsDeviceAddress(uint64_t _fieldsDeviceAddress) {
+    fieldsDeviceAddress = _fieldsDeviceAddress;
+}
+
+void setExtensionsDefine(
+        std::map<std::string, std::string>& preprocessorDefines, const std::vector<std::string>& extensions) {
+    if (!extensions.empty()) {
+        std::string extensionsString;
+        for (size_t i = 0; i < extensions.size(); ++i) {
+            if (i != 0) {
+                extensionsString += ";";
+            }
+            extensionsString += extensions[i];
+        }
+        preprocessorDefines.insert(std::make_pair("__extensions", extensionsString));
+    }
+}
+
+void BufferTestComputePass::addPreprocessorDefines(
+        std::map<std::string, std::string>& preprocessorDefines, std::vector<std::string>& extensions) {
+    if (testMode == TestMode::STORAGE_BUFFER || testMode == TestMode::STORAGE_BUFFER_64_BIT) {
+        preprocessorDefines.insert(std::make_pair("INPUT_STORAGE_BUFFER", ""));
+    } else if (testMode == TestMode::STORAGE_BUFFER_ARRAY) {
+        preprocessorDefines.insert(std::make_pair("INPUT_STORAGE_BUFFER_ARRAY", ""));
+        // Size of the descriptor array; can't be a push constant.
+        preprocessorDefines.insert(std::make_pair("MEMBER_COUNT", std::to_string(cs)));
+    } else if (testMode == TestMode::BUFFER_REFERENCE || testMode == TestMode::BUFFER_REFERENCE_64_BIT) {
+        preprocessorDefines.insert(std::make_pair("INPUT_BUFFER_REFERENCE", ""));
+    } else if (testMode == TestMode::BUFFER_REFERENCE_ARRAY || testMode == TestMode::BUFFER_REFERENCE_ARRAY_64_BIT) {
+        preprocessorDefines.insert(std::make_pair("INPUT_BUFFER_REFERENCE_ARRAY", ""));
+    }
+    if (getTestModeUses64BitIndexing(testMode)) {
+        // https://github.com/KhronosGroup/GLSL/blob/main/extensions/ext/GL_EXT_shader_64bit_indexing.txt
+        // https://github.khronos.org/SPIRV-Registry/extensions/EXT/SPV_EXT_shader_64bit_indexing.html
+        extensions.emplace_back("GL_EXT_shader_64bit_indexing");
+        preprocessorDefines.insert(std::make_pair("USE_64_BIT_INDEXING", ""));
+    }
+    addDataTypePreprocessorDefines(dataType, preprocessorDefines, extensions);
+}
+
+void addDataTypePreprocessorDefines(
+        TestDataType dataType, std::map<std::string, std::string>& preprocessorDefines,
+        std::vector<std::string>& extensions) {
+    // The GLSL type names match TEST_DATA_TYPE_NAMES.
+    preprocessorDefines.insert(std::make_pair("DATA_TYPE", TEST_DATA_TYPE_NAMES[int(dataType)]));
+    preprocessorDefines.insert(std::make_pair("DATA_TYPE_SIZE", std::to_string(getTestDataTypeSize(dataType))));
+    if (dataType == TestDataType::UINT8) {
+        extensions.emplace_back("GL_EXT_shader_8bit_storage");
+        extensions.emplace_back("GL_EXT_shader_explicit_arithmetic_types_int8");
+    } else if (dataType == TestDataType::FLOAT16 || dataType == TestDataType::F16VEC4) {
+        extensions.emplace_back("GL_EXT_shader_16bit_storage");
+        extensions.emplace_back("GL_EXT_shader_explicit_arithmetic_types_float16");
+    } else if (dataType == TestDataType::UINT16) {
+        extensions.emplace_back("GL_EXT_shader_16bit_storage");
+        extensions.emplace_back("GL_EXT_shader_explicit_arithmetic_types_int16");
+    } else if (dataType == TestDataType::UINT32) {
+        // The uint32_t keyword is not enabled by the int64 extension the kernels require.
+        extensions.emplace_back("GL_EXT_shader_explicit_arithmetic_types_int32");
+    }
+}
+
+bool getIsTestDataTypeSupported(sgl::vk::Device* device, TestDataType dataType) {
+    if (dataType == TestDataType::UINT8) {
+        return device->getPhysicalDeviceVulkan12Features().storageBuffer8BitAccess;
+    }
+    if (dataType == TestDataType::FLOAT16 || dataType == TestDataType::F16VEC4) {
+        return device->getPhysicalDeviceVulkan11Features().storageBuffer16BitAccess
+                && device->getPhysicalDeviceVulkan12Features().shaderFloat16;
+    }
+    if (dataType == TestDataType::UINT16) {
+        return device->getPhysicalDeviceVulkan11Features().storageBuffer16BitAccess
+                && device->getPhysicalDeviceFeatures().shaderInt16;
+    }
+    return true;
+}
+
+void BufferTestComputePass::loadShader() {
+    std::map<std::string, std::string> preprocessorDefines;
+    std::vector<std::string> extensions;
+    addPreprocessorDefines(preprocessorDefines, extensions);
+    setExtensionsDefine(preprocessorDefines, extensions);
+    shaderStages = shaderCache->getShaderStages("TestBuffer.Compute", preprocessorDefines);
+}
+
+void BufferTestComputePass::setComputePipelineInfo(sgl::vk::ComputePipelineInfo& pipelineInfo) {
+    if (getTestModeUses64BitIndexing(testMode)) {
+        // https://docs.vulkan.org/refpages/latest/refpages/source/VK_EXT_shader_64bit_indexing.html
+        pipelineInfo.setUse64BitIndexing(true);
+    }
+}
+
+void BufferTestComputePass::createComputeData(sgl::vk::Renderer* renderer, sgl::vk::ComputePipelinePtr& computePipeline) {
+    computeData = std::make_shared<sgl::vk::ComputeData>(renderer, computePipeline);
+    computeData->setStaticBuffer(outputBuffer, "OutputBuffer");
+    if (testMode == TestMode::STORAGE_BUFFER || testMode == TestMode::STORAGE_BUFFER_64_BIT) {
+        computeData->setStaticBuffer(fieldsBuffer, "InputBuffer");
+    } else if (testMode == TestMode::STORAGE_BUFFER_ARRAY) {
+        computeData->setStaticBufferArray(fieldBuffers, "InputBuffers");
+    } else if (testMode == TestMode::BUFFER_REFERENCE || testMode == TestMode::BUFFER_REFERENCE_64_BIT) {
+        computeData->setStaticBuffer(fieldsBuffer, "InputBuffer");
+    } else if (testMode == TestMode::BUFFER_REFERENCE_ARRAY || testMode == TestMode::BUFFER_REFERENCE_ARRAY_64_BIT) {
+        computeData->setStaticBuffer(uniformBuffer, "UniformBuffer");
+    }
+}
+
+void BufferTestComputePass::updateUniformBuffer() {
+    if (testMode == TestMode::BUFFER_REFERENCE_ARRAY || testMode == TestMode::BUFFER_REFERENCE_ARRAY_64_BIT) {
+        uint64_t val = fieldsDeviceAddress != 0 ? fieldsDeviceAddress : fieldsBuffer->getVkDeviceAddress();
+        uniformBuffer->updateData(sizeof(uint64_t), &val, renderer->getVkCommandBuffer());
+        renderer->insertBufferMemoryBarrier(
+                VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_UNIFORM_READ_BIT,
+                VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                uniformBuffer);
+        computeData->setStaticBuffer(uniformBuffer, "UniformBuffer");
+    }
+}
+
+void BufferTestComputePass::pushConstants() {
+    // Needs to match the layout of the push constant block in the shaders.
+    struct PushConstants {
+        uint32_t outputSlot;
+        uint32_t xs, ys, zs, cs;
+    };
+    PushConstants pushConstantsData{ outputSlot, xs, ys, zs, cs };
+    renderer->pushConstants(computeData->getComputePipeline(), VK_SHADER_STAGE_COMPUTE_BIT, 0, pushConstantsData);
+}
+
+void BufferTestComputePass::_render() {
+    updateUniformBuffer();
+    pushConstants();
+    renderer->dispatch(computeData, 1, 1, 1);
+}
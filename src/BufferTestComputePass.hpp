@@ -0,0 +1,102 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef BUFFERTEST64_BUFFERTESTCOMPUTEPASS_HPP
+#define BUFFERTEST64_BUFFERTESTCOMPUTEPASS_HPP
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <Graphics/Vulkan/Buffers/Buffer.hpp>
+#include <Graphics/Vulkan/Render/Passes/Pass.hpp>
+
+#include "TestTypes.hpp"
+
+class ShaderCache;
+
+/**
+ * Reads the last entry of the fields buffer(s) with the access path selected by the test mode and writes it to the
+ * output slot of the output buffer. Passes of multiple test modes can share one output buffer using different slots.
+ */
+class BufferTestComputePass : public sgl::vk::ComputePass {
+public:
+    BufferTestComputePass(
+            sgl::vk::Renderer* renderer, ShaderCache* shaderCache, uint32_t xs, uint32_t ys, uint32_t zs, uint32_t cs);
+    void setTestMode(TestMode _testMode);
+    void setDataType(TestDataType _dataType);
+    void setFieldsBuffer(const sgl::vk::BufferPtr& _fieldsBuffer);
+    void setFieldBuffers(const std::vector<sgl::vk::BufferPtr>& _fieldBuffers);
+    /**
+     * Reads the fields from a raw device address in the buffer reference array modes instead of from the fields buffer,
+     * e.g., for imported host memory not owned by an sgl buffer. An address of zero uses the fields buffer again.
+     */
+    void setFieldsDeviceAddress(uint64_t _fieldsDeviceAddress);
+    /// Sets the buffer and the entry index (in units of the data type) the result is written to.
+    void setOutputBuffer(const sgl::vk::BufferPtr& _outputBuffer, uint32_t _outputSlot);
+    /// Changes the dimensions of the fields; except for the buffer array mode, this does not need a shader rebuild.
+    void setDimensions(uint32_t _xs, uint32_t _ys, uint32_t _zs, uint32_t _cs);
+
+protected:
+    void loadShader() override;
+    void setComputePipelineInfo(sgl::vk::ComputePipelineInfo& pipelineInfo) override;
+    void createComputeData(sgl::vk::Renderer* renderer, sgl::vk::ComputePipelinePtr& computePipeline) override;
+    void _render() override;
+
+    /// Adds the defines and GLSL extensions that select the buffer access path for the test mode and data type.
+    void addPreprocessorDefines(
+            std::map<std::string, std::string>& preprocessorDefines, std::vector<std::string>& extensions);
+    /// Updates the uniform buffer holding the device address used by the buffer reference array modes.
+    void updateUniformBuffer();
+    void pushConstants();
+
+    ShaderCache* shaderCache;
+    uint32_t xs, ys, zs, cs;
+    sgl::vk::BufferPtr uniformBuffer;
+    sgl::vk::BufferPtr outputBuffer;
+    uint32_t outputSlot = 0;
+    TestMode testMode = TestMode::STORAGE_BUFFER;
+    TestDataType dataType = TestDataType::FLOAT;
+    sgl::vk::BufferPtr fieldsBuffer;
+    std::vector<sgl::vk::BufferPtr> fieldBuffers;
+    uint64_t fieldsDeviceAddress = 0;
+};
+
+/// Whether the device supports the storage buffer access and arithmetic of the data type used by the shaders.
+bool getIsTestDataTypeSupported(sgl::vk::Device* device, TestDataType dataType);
+
+/// Adds DATA_TYPE, DATA_TYPE_SIZE and the GLSL extensions needed for storing the data type in buffers.
+void addDataTypePreprocessorDefines(
+        TestDataType dataType, std::map<std::string, std::string>& preprocessorDefines,
+        std::vector<std::string>& extensions);
+
+/// Joins the extensions into the special define "__extensions" understood by the ShaderCache preprocessor.
+void setExtensionsDefine(
+        std::map<std::string, std::string>& preprocessorDefines, const std::vector<std::string>& extensions);
+
+#endif //BUFFERTEST64_BUFFERTESTCOMPUTEPASS_HPP
@@ -0,0 +1,99 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <algorithm>
+#include <numeric>
+
+#include <Math/Math.hpp>
+#include <Graphics/Vulkan/Utils/Device.hpp>
+#include <Graphics/Vulkan/Render/Renderer.hpp>
+
+#include "ShaderCache.hpp"
+#include "BufferWriteComputePass.hpp"
+
+// Minimum number of entries between the targets of two consecutive invocations; raised to the next stride coprime with
+// the member size, so the scattered index stream is a permutation of the member.
+static const uint32_t SCATTER_STRIDE = 4099;
+
+BufferWriteComputePass::BufferWriteComputePass(
+        sgl::vk::Renderer* renderer, ShaderCache* shaderCache, uint32_t xs, uint32_t ys, uint32_t zs, uint32_t cs,
+        uint32_t workgroupSize)
+        : BufferTestComputePass(renderer, shaderCache, xs, ys, zs, cs), workgroupSize(workgroupSize) {
+}
+
+void BufferWriteComputePass::setWriteOperation(WriteOperation _writeOperation) {
+    writeOperation = _writeOperation;
+    setDataType(writeOperation == WriteOperation::ATOMIC_ADD_64 ? TestDataType::UINT64 : TestDataType::UINT32);
+}
+
+void BufferWriteComputePass::setVerify(bool _verify, uint32_t _numUpdateIterations) {
+    if (verify != _verify) {
+        setShaderDirty();
+    }
+    verify = _verify;
+    numUpdateIterations = _numUpdateIterations;
+}
+
+void BufferWriteComputePass::loadShader() {
+    std::map<std::string, std::string> preprocessorDefines;
+    std::vector<std::string> extensions;
+    addPreprocessorDefines(preprocessorDefines, extensions);
+    if (writeOperation == WriteOperation::ATOMIC_ADD_64) {
+        extensions.emplace_back("GL_EXT_shader_atomic_int64");
+    }
+    setExtensionsDefine(preprocessorDefines, extensions);
+    preprocessorDefines.insert(std::make_pair("BLOCK_SIZE", std::to_string(workgroupSize)));
+    if (writeOperation == WriteOperation::SCATTERED_STORE) {
+        preprocessorDefines.insert(std::make_pair("WRITE_SCATTERED_STORE", ""));
+    } else if (writeOperation == WriteOperation::ATOMIC_MAX) {
+        preprocessorDefines.insert(std::make_pair("WRITE_ATOMIC_MAX", ""));
+    }
+    if (verify) {
+        preprocessorDefines.insert(std::make_pair("VERIFY", ""));
+    }
+    shaderStages = shaderCache->getShaderStages("WriteBuffer.Compute", preprocessorDefines);
+}
+
+void BufferWriteComputePass::_render() {
+    updateUniformBuffer();
+    pushConstants();
+    // The dimensions may change without a shader rebuild, so the stride is a push constant.
+    uint32_t numEntries3D = xs * ys * zs;
+    uint32_t scatterStride = SCATTER_STRIDE;
+    while (numEntries3D != 0 && std::gcd(uint64_t(scatterStride), uint64_t(numEntries3D)) != 1) {
+        scatterStride++;
+    }
+    // Appended to the push constants of the base class.
+    const uint32_t writePushConstants[2] = { numUpdateIterations, scatterStride };
+    renderer->pushConstants(
+            computeData->getComputePipeline(), VK_SHADER_STAGE_COMPUTE_BIT, 5 * sizeof(uint32_t),
+            writePushConstants);
+    // Enough work groups to saturate the device; the grid-stride loop covers the remaining entries.
+    uint32_t numWorkgroups = sgl::uiceil(numEntries3D, workgroupSize);
+    numWorkgroups = std::min(numWorkgroups, std::min(device->getLimits().maxComputeWorkGroupCount[0], 65535u));
+    renderer->dispatch(computeData, numWorkgroups, 1, 1);
+}
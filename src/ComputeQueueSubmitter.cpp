@@ -0,0 +1,67 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <Graphics/Vulkan/Utils/Device.hpp>
+#include <Graphics/Vulkan/Render/Renderer.hpp>
+
+#include "ComputeQueueSubmitter.hpp"
+
+ComputeQueueSubmitter::ComputeQueueSubmitter(sgl::vk::Device* device) : device(device) {
+    timelineSemaphore = std::make_shared<sgl::vk::Semaphore>(device, 0, VK_SEMAPHORE_TYPE_TIMELINE, 0);
+    sgl::vk::CommandPoolType commandPoolType{};
+    commandPoolType.queueFamilyIndex = device->getComputeQueueIndex();
+    commandPoolType.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+    commandBuffer = device->allocateCommandBuffer(commandPoolType, &commandPool);
+    renderer = std::make_unique<sgl::vk::Renderer>(device, 2000);
+}
+
+ComputeQueueSubmitter::~ComputeQueueSubmitter() {
+    renderer.reset();
+    device->freeCommandBuffer(commandPool, commandBuffer);
+}
+
+void ComputeQueueSubmitter::begin() {
+    renderer->setCustomCommandBuffer(commandBuffer, false);
+    renderer->beginCommandBuffer();
+}
+
+void ComputeQueueSubmitter::submit() {
+    submit({}, VK_PIPELINE_STAGE_TRANSFER_BIT);
+}
+
+void ComputeQueueSubmitter::submit(
+        const std::vector<sgl::vk::SemaphorePtr>& waitSemaphores, VkPipelineStageFlags waitStageMask) {
+    renderer->endCommandBuffer();
+    timelineValue++;
+    timelineSemaphore->setSignalSemaphoreValue(timelineValue);
+    renderer->submitToQueue(waitSemaphores, { timelineSemaphore }, {}, waitStageMask);
+    renderer->resetCustomCommandBuffer();
+}
+
+void ComputeQueueSubmitter::wait() {
+    timelineSemaphore->waitSemaphoreVk(timelineValue);
+}
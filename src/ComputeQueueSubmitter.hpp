@@ -0,0 +1,75 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef BUFFERTEST64_COMPUTEQUEUESUBMITTER_HPP
+#define BUFFERTEST64_COMPUTEQUEUESUBMITTER_HPP
+
+#include <memory>
+#include <vector>
+
+#include <Graphics/Vulkan/Utils/SyncObjects.hpp>
+
+namespace sgl { namespace vk {
+class Device;
+class Renderer;
+}}
+
+/**
+ * Owns a command buffer on the compute queue of a device and a renderer recording into it. The recorded commands are
+ * submitted with a timeline semaphore the host waits on. The submitter can be reused, i.e., begin() may be called again
+ * after the previous submission has finished.
+ */
+class ComputeQueueSubmitter {
+public:
+    explicit ComputeQueueSubmitter(sgl::vk::Device* device);
+    ~ComputeQueueSubmitter();
+    ComputeQueueSubmitter(const ComputeQueueSubmitter&) = delete;
+    ComputeQueueSubmitter& operator=(const ComputeQueueSubmitter&) = delete;
+
+    /// Starts recording into the command buffer. Needs to be called before recording the commands of each submission.
+    void begin();
+    /// Ends the recording and submits the command buffer to the compute queue.
+    void submit();
+    /// Like submit(), but the execution first waits on the given semaphores at the stages in waitStageMask.
+    void submit(const std::vector<sgl::vk::SemaphorePtr>& waitSemaphores, VkPipelineStageFlags waitStageMask);
+    /// Waits on the host until the last submission has finished executing.
+    void wait();
+    inline void submitAndWait() { submit(); wait(); }
+
+    [[nodiscard]] inline sgl::vk::Renderer* getRenderer() { return renderer.get(); }
+    [[nodiscard]] inline VkCommandBuffer getVkCommandBuffer() { return commandBuffer; }
+
+private:
+    sgl::vk::Device* device;
+    std::unique_ptr<sgl::vk::Renderer> renderer;
+    sgl::vk::SemaphorePtr timelineSemaphore;
+    uint64_t timelineValue = 0;
+    VkCommandPool commandPool{};
+    VkCommandBuffer commandBuffer{};
+};
+
+#endif //BUFFERTEST64_COMPUTEQUEUESUBMITTER_HPP
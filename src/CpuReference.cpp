@@ -0,0 +1,328 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <iomanip>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+
+#include <ImGui/Widgets/NumberFormatting.hpp>
+
+#include "FieldsBuffers.hpp"
+#include "MemoryBudget.hpp"
+#include "CpuReference.hpp"
+
+// Entries of one member read per inner loop, comparable to the entries of one member read by a workgroup.
+static const uint32_t CPU_BLOCK_SIZE = 256;
+
+struct CpuFields {
+    const float* values;
+    // Member pointers for the storage buffer array mode; all point into values.
+    std::vector<const float*> memberPointers;
+    uint32_t cs;
+    uint32_t numEntries3D;
+};
+
+/// Whether the byte offset of the array indexing of the mode is computed by the driver and not in the shader.
+static bool getTestModeMayWrapByteOffset(TestMode testMode) {
+    return !getTestModeUses64BitIndexing(testMode) && testMode != TestMode::BUFFER_REFERENCE_ARRAY;
+}
+
+/// Byte offset of an entry index, optionally computed in 32 bits, i.e., wrapping around at 4 GiB.
+static uint64_t getByteOffset(uint32_t entryIdx, bool wrapByteOffset) {
+    uint64_t byteOffset = sizeof(float) * uint64_t(entryIdx);
+    return wrapByteOffset ? uint64_t(uint32_t(byteOffset)) : byteOffset;
+}
+
+/**
+ * Returns the address of entry i of member c computed like the shader of the test mode does (see BufferAccess.glsl).
+ * If wrapByteOffset is set, the byte offsets of the modes indexing an array without 64-bit indexing wrap around at
+ * 4 GiB. The buffer reference array mode computes its 64-bit address in the shader and is not affected.
+ */
+static const float* getEntryAddress(
+        TestMode testMode, const CpuFields& fields, uint32_t i, uint32_t c, bool wrapByteOffset) {
+    auto* bytes = reinterpret_cast<const uint8_t*>(fields.values);
+    switch (testMode) {
+    case TestMode::STORAGE_BUFFER:
+    case TestMode::BUFFER_REFERENCE:
+        // IDXL without 64-bit indexing; uint arithmetic wraps around at 2^32 entries.
+        return reinterpret_cast<const float*>(bytes + getByteOffset(c * fields.numEntries3D + i, wrapByteOffset));
+    case TestMode::STORAGE_BUFFER_ARRAY:
+        return reinterpret_cast<const float*>(
+                reinterpret_cast<const uint8_t*>(fields.memberPointers[c]) + getByteOffset(i, wrapByteOffset));
+    case TestMode::BUFFER_REFERENCE_ARRAY:
+        return reinterpret_cast<const float*>(bytes + getByteOffset(c * fields.numEntries3D + i, false));
+    case TestMode::STORAGE_BUFFER_64_BIT:
+    case TestMode::BUFFER_REFERENCE_64_BIT:
+        return fields.values + (uint64_t(c) * uint64_t(fields.numEntries3D) + uint64_t(i));
+    case TestMode::BUFFER_REFERENCE_ARRAY_64_BIT:
+        return reinterpret_cast<const float*>(
+                bytes + sizeof(float) * (uint64_t(c) * uint64_t(fields.numEntries3D) + uint64_t(i)));
+    }
+    return fields.values;
+}
+
+/// Whether the addresses of the entries [i, i + count) of member c are contiguous, i.e., no 32-bit index wraps.
+static bool getIsBlockContiguous(
+        TestMode testMode, const CpuFields& fields, uint32_t i, uint32_t c, uint32_t count, bool wrapByteOffset) {
+    if (getTestModeUses64BitIndexing(testMode)) {
+        return true;
+    }
+    uint32_t firstIdx = testMode == TestMode::STORAGE_BUFFER_ARRAY ? i : c * fields.numEntries3D + i;
+    if (uint64_t(firstIdx) + uint64_t(count) > uint64_t(UINT32_MAX) + 1) {
+        return false;
+    }
+    if (wrapByteOffset && getTestModeMayWrapByteOffset(testMode)) {
+        return getByteOffset(firstIdx, true) + sizeof(float) * uint64_t(count) <= uint64_t(UINT32_MAX) + 1;
+    }
+    return true;
+}
+
+/// Whether the largest byte offset indexed by the mode lies past 4 GiB, so wrapping it changes the entries read.
+static bool getMayWrapByteOffset(TestMode testMode, const CpuFields& fields) {
+    if (!getTestModeMayWrapByteOffset(testMode)) {
+        return false;
+    }
+    uint64_t numEntriesIndexed = uint64_t(fields.numEntries3D);
+    if (testMode != TestMode::STORAGE_BUFFER_ARRAY) {
+        numEntriesIndexed *= uint64_t(fields.cs);
+    }
+    return sizeof(float) * numEntriesIndexed > uint64_t(UINT32_MAX) + 1;
+}
+
+/**
+ * Counts the entries of src[0, count) not matching the index pattern float(firstIdx + k). Like writeIndexPattern, it
+ * uses int32_t -> float conversions where possible, as they can be vectorized on all x86-64 and ARMv8 targets.
+ */
+static size_t countIndexPatternMismatches(const float* src, uint64_t firstIdx, uint32_t count) {
+    size_t numMismatches = 0;
+    if (firstIdx + count <= uint64_t(INT32_MAX)) {
+        auto firstIdxSigned = int32_t(firstIdx);
+        auto countSigned = int32_t(count);
+        for (int32_t k = 0; k < countSigned; k++) {
+            numMismatches += src[k] != float(firstIdxSigned + k) ? 1 : 0;
+        }
+    } else {
+        for (uint32_t k = 0; k < count; k++) {
+            numMismatches += src[k] != float(firstIdx + k) ? 1 : 0;
+        }
+    }
+    return numMismatches;
+}
+
+/// Reads the entries [begin, end) of all members like the benchmark kernel and counts the mismatches.
+static size_t scanEntries(
+        TestMode testMode, const CpuFields& fields, uint32_t begin, uint32_t end, bool wrapByteOffset) {
+    size_t numMismatches = 0;
+    for (uint32_t blockStart = begin; blockStart < end; blockStart += CPU_BLOCK_SIZE) {
+        uint32_t blockEnd = std::min(blockStart + CPU_BLOCK_SIZE, end);
+        for (uint32_t c = 0; c < fields.cs; c++) {
+            // The last entry holds 42 instead of its index and is checked on its own.
+            bool isLastBlock = c == fields.cs - 1 && blockEnd == fields.numEntries3D;
+            uint32_t count = blockEnd - blockStart - (isLastBlock ? 1 : 0);
+            uint64_t firstIdx = uint64_t(c) * uint64_t(fields.numEntries3D) + uint64_t(blockStart);
+            if (getIsBlockContiguous(testMode, fields, blockStart, c, count, wrapByteOffset)) {
+                numMismatches += countIndexPatternMismatches(
+                        getEntryAddress(testMode, fields, blockStart, c, wrapByteOffset), firstIdx, count);
+            } else {
+                for (uint32_t k = 0; k < count; k++) {
+                    numMismatches += countIndexPatternMismatches(
+                            getEntryAddress(testMode, fields, blockStart + k, c, wrapByteOffset), firstIdx + k, 1);
+                }
+            }
+            if (isLastBlock && *getEntryAddress(testMode, fields, blockEnd - 1, c, wrapByteOffset) != 42.0f) {
+                numMismatches++;
+            }
+        }
+    }
+    return numMismatches;
+}
+
+void GpuTestResults::add(const GpuTestResult& result) {
+    std::lock_guard<std::mutex> lock(mutex);
+    results.push_back(result);
+}
+
+std::vector<GpuTestResult> GpuTestResults::getResults(const std::array<uint32_t, 4>& allocSize) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<GpuTestResult> matchingResults;
+    for (const GpuTestResult& result : results) {
+        if (result.allocSize == allocSize) {
+            matchingResults.push_back(result);
+        }
+    }
+    return matchingResults;
+}
+
+struct CpuModeResult {
+    float lastEntry = 0.0f;
+    size_t numMismatches = 0;
+    [[nodiscard]] inline double getValue(bool benchmarkMode) const {
+        return benchmarkMode ? double(numMismatches) : double(lastEntry);
+    }
+};
+
+/// Reads the last entry and scans all entries of a mode on all hardware threads. Returns the time of the scan.
+static double scanMode(TestMode testMode, const CpuFields& fields, bool wrapByteOffset, CpuModeResult& modeResult) {
+    // Same entry as read by the test kernel, IDXM(xs-1, ys-1, zs-1, cs-1).
+    modeResult.lastEntry = *getEntryAddress(testMode, fields, fields.numEntries3D - 1, fields.cs - 1, wrapByteOffset);
+    std::atomic<size_t> numMismatches{0};
+    // parallelFill only schedules the blocks; the scan does not write anything.
+    FillStatistics scanStatistics = parallelFill(
+            fields.numEntries3D, size_t(fields.cs) * sizeof(float), [&](size_t begin, size_t end) {
+        numMismatches += scanEntries(testMode, fields, uint32_t(begin), uint32_t(end), wrapByteOffset);
+    });
+    modeResult.numMismatches = numMismatches.load();
+    return scanStatistics.timeSeconds;
+}
+
+/**
+ * Mismatch counts need to be equal. The last entry holds the index pattern, which the GPU generator may convert from
+ * the 64-bit index with another rounding than the CPU above 2^24, so it may differ by one unit in the last place.
+ */
+static bool getAreResultValuesEqual(double gpuValue, double cpuValue, bool benchmarkMode) {
+    if (gpuValue == cpuValue) {
+        return true;
+    }
+    if (benchmarkMode || !std::isfinite(gpuValue) || cpuValue < double(1 << 24)) {
+        return false;
+    }
+    return std::abs(gpuValue - cpuValue) <= std::ldexp(1.0, std::ilogb(cpuValue) - 23);
+}
+
+void runCpuReference(
+        const TestSettings& testSettings, std::ostream& out, const std::array<uint32_t, 4>& allocSize,
+        const GpuTestResults* gpuTestResults) {
+    const uint32_t xs = allocSize[0], ys = allocSize[1], zs = allocSize[2], cs = allocSize[3];
+    const size_t numEntries3D = size_t(xs) * size_t(ys) * size_t(zs);
+    const size_t numEntries = numEntries3D * size_t(cs);
+    const size_t sizeInBytes = numEntries * sizeof(float);
+    out << std::endl;
+    out
+            << "CPU reference: " << sgl::getNiceMemoryString(sizeInBytes, 2) << " (" << xs << "x" << ys << "x" << zs
+            << "x" << cs << " floats), " << std::max(std::thread::hardware_concurrency(), 1u) << " threads"
+            << std::endl;
+    if (numEntries3D > size_t(UINT32_MAX)) {
+        out << "Skipped: The shaders use 32-bit indices for the entries of one member." << std::endl;
+        return;
+    }
+    if (sizeInBytes > MemoryBudget::getHostAvailableBytes()) {
+        out << "Skipped: Not enough free host memory." << std::endl;
+        return;
+    }
+    auto* values = static_cast<float*>(std::malloc(sizeInBytes));
+    if (!values) {
+        out << "Skipped: Allocating the host copy failed." << std::endl;
+        return;
+    }
+    FillStatistics fillStatistics = fillFieldsPattern(TestDataType::FLOAT, numEntries, values, 0, sizeInBytes);
+    printFillStatistics(out, fillStatistics);
+
+    CpuFields fields{};
+    fields.values = values;
+    fields.cs = cs;
+    fields.numEntries3D = uint32_t(numEntries3D);
+    for (uint32_t c = 0; c < cs; c++) {
+        fields.memberPointers.push_back(values + size_t(c) * numEntries3D);
+    }
+
+    const uint32_t numIterations = testSettings.benchmarkMode ? std::max(testSettings.benchmarkNumIterations, 1u) : 1u;
+    std::array<CpuModeResult, NUM_TESTS> modeResults{};
+    std::array<CpuModeResult, NUM_TESTS> wrappedModeResults{};
+    std::array<bool, NUM_TESTS> hasWrappedModeResults{};
+    out
+            << std::left << std::setw(34) << "Test mode" << std::right << std::setw(12) << "Last entry"
+            << std::setw(12) << "Read [ms]" << std::setw(12) << "GB/s" << std::setw(12) << "Mismatches" << std::endl;
+    for (int i = 0; i < NUM_TESTS; i++) {
+        auto testMode = TestMode(i);
+        if (!testSettings.testPlan.getIsTestModeSelected(testMode)) {
+            continue;
+        }
+        double readSeconds = 0.0;
+        for (uint32_t iteration = 0; iteration < numIterations; iteration++) {
+            readSeconds += scanMode(testMode, fields, false, modeResults.at(i));
+        }
+        readSeconds /= double(numIterations);
+
+        out << std::left << std::setw(34) << TEST_MODE_NAMES[i] << std::right;
+        out << std::setw(12) << modeResults.at(i).lastEntry;
+        out << std::fixed << std::setprecision(2);
+        out << std::setw(12) << (readSeconds * 1e3);
+        out << std::setw(12) << (readSeconds > 0.0 ? double(sizeInBytes) / readSeconds * 1e-9 : 0.0);
+        out << std::setw(12) << modeResults.at(i).numMismatches << std::endl;
+        out.unsetf(std::ios_base::floatfield);
+        out << std::setprecision(6);
+
+        if (getMayWrapByteOffset(testMode, fields)) {
+            // Not timed, as it models the failure and not the bandwidth of a correct implementation.
+            scanMode(testMode, fields, true, wrappedModeResults.at(i));
+            hasWrappedModeResults.at(i) = true;
+            out << std::left << std::setw(34) << "  with 32-bit byte offsets" << std::right;
+            out << std::setw(12) << wrappedModeResults.at(i).lastEntry << std::setw(12) << "-" << std::setw(12) << "-";
+            out << std::setw(12) << wrappedModeResults.at(i).numMismatches << std::endl;
+        }
+    }
+    std::free(values);
+
+    if (!gpuTestResults) {
+        return;
+    }
+    std::vector<GpuTestResult> results = gpuTestResults->getResults(allocSize);
+    if (results.empty()) {
+        return;
+    }
+    out << "Cross-check of the GPU results:" << std::endl;
+    size_t numMatching = 0;
+    for (const GpuTestResult& result : results) {
+        // The devices use the same test plan, so the CPU reference has run all modes of the GPU results.
+        auto i = int(result.testMode);
+        double cpuValue = modeResults.at(i).getValue(result.benchmarkMode);
+        std::string verdict;
+        if (getAreResultValuesEqual(result.value, cpuValue, result.benchmarkMode)) {
+            verdict = "matches";
+            numMatching++;
+        } else if (hasWrappedModeResults.at(i) && getAreResultValuesEqual(
+                result.value, wrappedModeResults.at(i).getValue(result.benchmarkMode), result.benchmarkMode)) {
+            verdict = "matches 32-bit byte offsets";
+        } else {
+            verdict = "differs";
+        }
+        out
+                << result.deviceName << ", " << (result.useHostAllocation ? "host" : "device") << " allocation, "
+                << TEST_MODE_NAMES[i] << ": " << (result.benchmarkMode ? "mismatches " : "last entry ")
+                << result.value << " (CPU " << cpuValue;
+        if (hasWrappedModeResults.at(i)) {
+            out << ", with 32-bit byte offsets " << wrappedModeResults.at(i).getValue(result.benchmarkMode);
+        }
+        out << "): " << verdict << std::endl;
+    }
+    out << numMatching << " of " << results.size() << " GPU results match the CPU reference." << std::endl;
+}
@@ -0,0 +1,74 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef BUFFERTEST64_CPUREFERENCE_HPP
+#define BUFFERTEST64_CPUREFERENCE_HPP
+
+#include <array>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "Tests.hpp"
+
+/// Float result of one test mode of a fixed-size test case on a device, cross-checked by runCpuReference.
+struct GpuTestResult {
+    std::string deviceName;
+    std::array<uint32_t, 4> allocSize{};
+    bool useHostAllocation = false;
+    TestMode testMode = TestMode::STORAGE_BUFFER;
+    bool benchmarkMode = false;
+    // The value of the last entry in test mode and the number of mismatches of one iteration in benchmark mode.
+    double value = 0.0;
+};
+
+/// Collects the GPU results of the float test cases of all devices. Adding results is thread-safe.
+class GpuTestResults {
+public:
+    void add(const GpuTestResult& result);
+    [[nodiscard]] std::vector<GpuTestResult> getResults(const std::array<uint32_t, 4>& allocSize) const;
+
+private:
+    mutable std::mutex mutex;
+    std::vector<GpuTestResult> results;
+};
+
+/**
+ * Runs the access patterns of all selected test modes natively on the CPU over a host copy of the float fields buffer
+ * with the layout xs * ys * zs * cs. Each mode computes its addresses like its shader, i.e., the modes without 64-bit
+ * indexing compute the entry index in 32 bits. Reads the last entry and streams through all entries on all hardware
+ * threads in blocks the compiler can vectorize. Prints the value read, the read bandwidth and the mismatches per mode.
+ * For the modes indexing a buffer past 4 GiB without 64-bit indexing, the values for a driver computing the byte
+ * offset of the array indexing in 32 bits are printed, too, as this is the failure the tool tests for.
+ * If gpuTestResults is not null, the GPU results of the same allocation size are compared with both.
+ */
+void runCpuReference(
+        const TestSettings& testSettings, std::ostream& out, const std::array<uint32_t, 4>& allocSize,
+        const GpuTestResults* gpuTestResults = nullptr);
+
+#endif //BUFFERTEST64_CPUREFERENCE_HPP
@@ -0,0 +1,171 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <iomanip>
+#include <cstring>
+
+#include <Graphics/Vulkan/Utils/Device.hpp>
+#include <Graphics/Vulkan/Buffers/Buffer.hpp>
+#include <ImGui/Widgets/NumberFormatting.hpp>
+
+#include "FieldsBuffers.hpp"
+#include "FieldsGeneratorPass.hpp"
+#include "StreamingDownload.hpp"
+#include "DownloadBenchmark.hpp"
+
+static const size_t DOWNLOAD_NUM_ENTRIES = size_t(512) * size_t(512) * size_t(512) * size_t(10); // 5GiB of floats.
+
+static std::string getMemoryPropertyFlagsString(VkMemoryPropertyFlags flags) {
+    std::string flagsString;
+    const std::pair<VkMemoryPropertyFlags, const char*> flagNames[] = {
+            { VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, "device local" },
+            { VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, "host coherent" },
+            { VK_MEMORY_PROPERTY_HOST_CACHED_BIT, "host cached" },
+    };
+    for (const auto& flagName : flagNames) {
+        if ((flags & flagName.first) != 0) {
+            flagsString += flagsString.empty() ? "" : ", ";
+            flagsString += flagName.second;
+        }
+    }
+    return flagsString;
+}
+
+/// XOR of all 64-bit words of the chunk (and the zero-padded tail), which reads every byte once.
+static uint64_t foldChunk(const void* src, size_t byteSize) {
+    const auto* bytes = static_cast<const uint8_t*>(src);
+    const size_t numWords = byteSize / sizeof(uint64_t);
+    uint64_t checksum = 0;
+    for (size_t i = 0; i < numWords; i++) {
+        uint64_t word;
+        std::memcpy(&word, bytes + i * sizeof(uint64_t), sizeof(uint64_t));
+        checksum ^= word;
+    }
+    uint64_t tailWord = 0;
+    std::memcpy(&tailWord, bytes + numWords * sizeof(uint64_t), byteSize - numWords * sizeof(uint64_t));
+    return checksum ^ tailWord;
+}
+
+void runDownloadBenchmark(const TestSettings& testSettings, const TestContext& ctx) {
+    sgl::vk::Device* device = ctx.device;
+    const size_t sizeInBytes = DOWNLOAD_NUM_ENTRIES * sizeof(float);
+    ctx.out << std::endl;
+    ctx.out
+            << "Download benchmark: " << sgl::getNiceMemoryString(sizeInBytes, 2) << ", "
+            << testSettings.numStreamingChunks << " x "
+            << sgl::getNiceMemoryString(testSettings.streamingChunkSizeInBytes, 2) << " staging chunks" << std::endl;
+    sgl::vk::BufferPtr fieldsBuffer;
+    try {
+        fieldsBuffer = std::make_shared<sgl::vk::Buffer>(
+                device, sizeInBytes,
+                VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT
+                | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+                VMA_MEMORY_USAGE_GPU_ONLY);
+    } catch (const std::exception& e) {
+        ctx.out << "Allocation failed: " << e.what() << std::endl;
+        return;
+    }
+    generateFieldsPattern(ctx, TestDataType::FLOAT, fieldsBuffer, DOWNLOAD_NUM_ENTRIES);
+
+    ctx.out
+            << std::left << std::setw(44) << "Memory type" << std::right << std::setw(12) << "Time [ms]"
+            << std::setw(12) << "GB/s" << std::setw(14) << "Consume [ms]" << std::setw(12) << "Mismatches"
+            << std::endl;
+    const VkPhysicalDeviceMemoryProperties& deviceMemoryProperties = device->getMemoryProperties();
+    for (uint32_t memoryTypeIdx = 0; memoryTypeIdx < deviceMemoryProperties.memoryTypeCount; memoryTypeIdx++) {
+        const VkMemoryType& memoryType = deviceMemoryProperties.memoryTypes[memoryTypeIdx];
+        if ((memoryType.propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) == 0) {
+            continue;
+        }
+        // Uncached device coherent memory is meant for fine-grained synchronization, and allocating it needs the
+        // deviceCoherentMemory feature of VK_AMD_device_coherent_memory.
+        if ((memoryType.propertyFlags & VK_MEMORY_PROPERTY_DEVICE_COHERENT_BIT_AMD) != 0) {
+            continue;
+        }
+        std::string name =
+                "#" + std::to_string(memoryTypeIdx) + " heap " + std::to_string(memoryType.heapIndex) + ": "
+                + getMemoryPropertyFlagsString(memoryType.propertyFlags);
+        ctx.out << std::left << std::setw(44) << name << std::right;
+        std::unique_ptr<StreamingDownloader> downloader;
+        try {
+            downloader = std::make_unique<StreamingDownloader>(
+                    device, testSettings.streamingChunkSizeInBytes, testSettings.numStreamingChunks, memoryTypeIdx);
+        } catch (const std::exception& e) {
+            ctx.out << "  not usable: " << e.what() << std::endl;
+            continue;
+        }
+
+        // The timed download only folds the staging memory into a checksum, so it reads each staging byte once, but
+        // the bandwidth is not bounded by computing the expected pattern on the host.
+        uint64_t checksum = 0;
+        DownloadStatistics downloadStatistics = downloader->download(
+                fieldsBuffer, [&](const void* src, size_t, size_t byteSize) {
+            checksum ^= foldChunk(src, byteSize);
+        });
+
+        // A second, untimed download compares every entry with the pattern, like verifyFieldsPattern does, as the
+        // indices converted on the GPU may differ by one ulp from the host. A checksum differing from the timed
+        // download means that one read other data, which is counted as one more mismatch.
+        size_t numMismatchingChunks = 0;
+        uint64_t verifiedChecksum = 0;
+        downloader->download(fieldsBuffer, [&](const void* src, size_t byteOffset, size_t byteSize) {
+            const auto* bytes = static_cast<const uint8_t*>(src);
+            const size_t firstEntryIdx = byteOffset / sizeof(float);
+            const size_t numChunkEntries = byteSize / sizeof(float);
+            bool isChunkValid = true;
+            for (size_t i = 0; i < numChunkEntries && isChunkValid; i++) {
+                const size_t entryIdx = firstEntryIdx + i;
+                if (entryIdx == DOWNLOAD_NUM_ENTRIES - 1) {
+                    float expectedValue;
+                    fillFieldsPattern(
+                            TestDataType::FLOAT, DOWNLOAD_NUM_ENTRIES, &expectedValue, entryIdx * sizeof(float),
+                            sizeof(float));
+                    isChunkValid = std::memcmp(bytes + i * sizeof(float), &expectedValue, sizeof(float)) == 0;
+                } else {
+                    float value;
+                    std::memcpy(&value, bytes + i * sizeof(float), sizeof(float));
+                    isChunkValid = getIsIndexPatternValueValid(value, entryIdx);
+                }
+            }
+            if (!isChunkValid) {
+                numMismatchingChunks++;
+            }
+            verifiedChecksum ^= foldChunk(src, byteSize);
+        });
+        if (verifiedChecksum != checksum) {
+            numMismatchingChunks++;
+        }
+
+        ctx.out << std::fixed << std::setprecision(2);
+        ctx.out << std::setw(12) << (downloadStatistics.timeSeconds * 1e3);
+        ctx.out << std::setw(12) << downloadStatistics.getBandwidthGBs();
+        ctx.out << std::setw(14) << (downloadStatistics.consumeSeconds * 1e3);
+        ctx.out << std::setw(12) << numMismatchingChunks << std::endl;
+        ctx.out.unsetf(std::ios_base::floatfield);
+        ctx.out << std::setprecision(6);
+    }
+}
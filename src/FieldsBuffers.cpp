@@ -0,0 +1,363 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <limits>
+
+#include <Utils/File/Logfile.hpp>
+#include <ImGui/Widgets/NumberFormatting.hpp>
+
+#include "Timing.hpp"
+#include "StreamingUpload.hpp"
+#include "BufferArena.hpp"
+#include "SparseBuffer.hpp"
+#include "FieldsGeneratorPass.hpp"
+#include "FieldsBuffers.hpp"
+
+// Entries of a GPU-generated fields buffer that are read back and compared with the pattern computed on the host.
+static const size_t FIELDS_VERIFICATION_NUM_SAMPLES = 1024;
+
+/// Converts zero or a float exactly representable as a normal half-precision float to its bit pattern.
+static uint16_t convertFloatToHalfBits(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(uint32_t));
+    auto signBits = uint16_t((bits >> 16) & 0x8000u);
+    if ((bits & 0x7FFFFFFFu) == 0) {
+        return signBits;
+    }
+    auto exponent = uint32_t(int32_t((bits >> 23) & 0xFFu) - 127 + 15);
+    uint32_t mantissa = (bits >> 13) & 0x3FFu;
+    return uint16_t(signBits | (exponent << 10) | mantissa);
+}
+
+static float convertHalfBitsToFloat(uint16_t halfBits) {
+    uint32_t exponent = (halfBits >> 10) & 0x1Fu;
+    auto mantissa = float(halfBits & 0x3FFu);
+    float value;
+    if (exponent == 0) {
+        value = std::ldexp(mantissa, -24);
+    } else if (exponent == 31) {
+        value = mantissa == 0.0f ? std::numeric_limits<float>::infinity() : std::numeric_limits<float>::quiet_NaN();
+    } else {
+        value = std::ldexp(1024.0f + mantissa, int(exponent) - 25);
+    }
+    return (halfBits & 0x8000u) != 0 ? -value : value;
+}
+
+void writeDataTypeValue(TestDataType testDataType, void* dst, uint32_t value) {
+    const uint32_t numComponents = TEST_DATA_TYPE_NUM_COMPONENTS[int(testDataType)];
+    for (uint32_t i = 0; i < numComponents; i++) {
+        if (testDataType == TestDataType::FLOAT || testDataType == TestDataType::VEC4) {
+            static_cast<float*>(dst)[i] = float(value);
+        } else if (testDataType == TestDataType::UINT8) {
+            static_cast<uint8_t*>(dst)[i] = uint8_t(value);
+        } else if (testDataType == TestDataType::FLOAT16 || testDataType == TestDataType::F16VEC4) {
+            static_cast<uint16_t*>(dst)[i] = convertFloatToHalfBits(float(value));
+        } else if (testDataType == TestDataType::UINT16) {
+            static_cast<uint16_t*>(dst)[i] = uint16_t(value);
+        } else if (testDataType == TestDataType::UINT32 || testDataType == TestDataType::UVEC4) {
+            static_cast<uint32_t*>(dst)[i] = value;
+        } else if (testDataType == TestDataType::UINT64) {
+            static_cast<uint64_t*>(dst)[i] = value;
+        }
+    }
+}
+
+double readDataTypeValue(TestDataType testDataType, const void* src) {
+    const uint32_t numComponents = TEST_DATA_TYPE_NUM_COMPONENTS[int(testDataType)];
+    double firstValue = 0.0;
+    for (uint32_t i = 0; i < numComponents; i++) {
+        double value = 0.0;
+        if (testDataType == TestDataType::FLOAT || testDataType == TestDataType::VEC4) {
+            value = double(static_cast<const float*>(src)[i]);
+        } else if (testDataType == TestDataType::UINT8) {
+            value = double(static_cast<const uint8_t*>(src)[i]);
+        } else if (testDataType == TestDataType::FLOAT16 || testDataType == TestDataType::F16VEC4) {
+            value = double(convertHalfBitsToFloat(static_cast<const uint16_t*>(src)[i]));
+        } else if (testDataType == TestDataType::UINT16) {
+            value = double(static_cast<const uint16_t*>(src)[i]);
+        } else if (testDataType == TestDataType::UINT32 || testDataType == TestDataType::UVEC4) {
+            value = double(static_cast<const uint32_t*>(src)[i]);
+        } else if (testDataType == TestDataType::UINT64) {
+            value = double(static_cast<const uint64_t*>(src)[i]);
+        }
+        if (i == 0) {
+            firstValue = value;
+        } else if (value != firstValue) {
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+    }
+    return firstValue;
+}
+
+/// Writes value to the components [componentOffset, componentOffset + numLocalComponents) of the pattern.
+template<class T>
+static FillStatistics fillComponentPattern(
+        T* dst, size_t componentOffset, size_t numComponents, size_t numLocalComponents, T value) {
+    return parallelFill(numLocalComponents, sizeof(T), [=](size_t begin, size_t end) {
+        writeConstantPattern(
+                dst + begin, componentOffset + begin, componentOffset + end, numComponents, value, value);
+    });
+}
+
+FillStatistics fillFieldsPattern(
+        TestDataType testDataType, size_t numEntries, void* dst, size_t byteOffset, size_t byteSize) {
+    if (testDataType == TestDataType::FLOAT) {
+        auto* dstFloat = static_cast<float*>(dst);
+        size_t entryOffset = byteOffset / sizeof(float);
+        return parallelFill(byteSize / sizeof(float), sizeof(float), [=](size_t begin, size_t end) {
+            writeIndexPattern(dstFloat + begin, entryOffset + begin, entryOffset + end, numEntries, 42.0f);
+        });
+    }
+
+    // All other types are 7 in all components, except for the last entry, which is written below.
+    const size_t entrySize = getTestDataTypeSize(testDataType);
+    const size_t numComponentsPerEntry = TEST_DATA_TYPE_NUM_COMPONENTS[int(testDataType)];
+    const size_t componentSize = entrySize / numComponentsPerEntry;
+    const size_t numComponents = numEntries * numComponentsPerEntry;
+    const size_t componentOffset = byteOffset / componentSize;
+    const size_t numLocalComponents = byteSize / componentSize;
+    FillStatistics fillStatistics;
+    if (testDataType == TestDataType::VEC4) {
+        fillStatistics = fillComponentPattern(
+                static_cast<float*>(dst), componentOffset, numComponents, numLocalComponents, 7.0f);
+    } else if (componentSize == sizeof(uint8_t)) {
+        fillStatistics = fillComponentPattern(
+                static_cast<uint8_t*>(dst), componentOffset, numComponents, numLocalComponents, uint8_t(7));
+    } else if (componentSize == sizeof(uint16_t)) {
+        bool isHalf = testDataType == TestDataType::FLOAT16 || testDataType == TestDataType::F16VEC4;
+        fillStatistics = fillComponentPattern(
+                static_cast<uint16_t*>(dst), componentOffset, numComponents, numLocalComponents,
+                isHalf ? convertFloatToHalfBits(7.0f) : uint16_t(7));
+    } else if (componentSize == sizeof(uint32_t)) {
+        fillStatistics = fillComponentPattern(
+                static_cast<uint32_t*>(dst), componentOffset, numComponents, numLocalComponents, uint32_t(7));
+    } else {
+        fillStatistics = fillComponentPattern(
+                static_cast<uint64_t*>(dst), componentOffset, numComponents, numLocalComponents, uint64_t(7));
+    }
+
+    // The byte range may only cover a part of the last entry, e.g., when patching a single word.
+    const size_t lastEntryOffset = (numEntries - 1) * entrySize;
+    if (lastEntryOffset < byteOffset + byteSize && lastEntryOffset + entrySize > byteOffset) {
+        uint8_t lastEntry[MAX_TEST_DATA_TYPE_SIZE];
+        writeDataTypeValue(testDataType, lastEntry, 42);
+        size_t begin = std::max(lastEntryOffset, byteOffset);
+        size_t end = std::min(lastEntryOffset + entrySize, byteOffset + byteSize);
+        std::memcpy(
+                static_cast<uint8_t*>(dst) + (begin - byteOffset), lastEntry + (begin - lastEntryOffset), end - begin);
+    }
+    return fillStatistics;
+}
+
+void uploadFieldBuffersPattern(
+        const TestSettings& testSettings, const TestContext& ctx, const std::vector<sgl::vk::BufferPtr>& fieldBuffers,
+        size_t numEntries3D, FieldsBufferTimings& timings) {
+    StreamingUploader streamingUploader(
+            ctx.device, testSettings.streamingChunkSizeInBytes, testSettings.numStreamingChunks);
+    UploadStatistics totalUploadStatistics{};
+    for (size_t j = 0; j < fieldBuffers.size(); j++) {
+        float lastValue = j == fieldBuffers.size() - 1 ? 42.0f : 0.0f;
+        // The fill function is only called from the producer thread, which is joined before upload returns.
+        UploadStatistics uploadStatistics = streamingUploader.upload(
+                fieldBuffers.at(j), [&](void* dst, size_t byteOffset, size_t byteSize) {
+            auto* dstFloat = static_cast<float*>(dst);
+            size_t entryOffset = byteOffset / sizeof(float);
+            timings.fillSeconds += parallelFill(
+                    byteSize / sizeof(float), sizeof(float), [=](size_t begin, size_t end) {
+                writeConstantPattern(
+                        dstFloat + begin, entryOffset + begin, entryOffset + end, numEntries3D, 7.0f, lastValue);
+            }).timeSeconds;
+        });
+        totalUploadStatistics.sizeInBytes += uploadStatistics.sizeInBytes;
+        totalUploadStatistics.timeSeconds += uploadStatistics.timeSeconds;
+        totalUploadStatistics.chunkSizeInBytes = uploadStatistics.chunkSizeInBytes;
+        totalUploadStatistics.numStagingChunks = uploadStatistics.numStagingChunks;
+    }
+    printUploadStatistics(ctx.out, totalUploadStatistics);
+    timings.uploadSeconds += totalUploadStatistics.timeSeconds;
+}
+
+std::vector<sgl::vk::BufferPtr> createFieldBuffers(
+        const TestSettings& testSettings, const TestContext& ctx, size_t numEntries3D, uint32_t cs,
+        FieldsBufferTimings* timings) {
+    sgl::vk::Device* device = ctx.device;
+    size_t sizeInBytes3D = sizeof(float) * numEntries3D;
+    if (testSettings.useBufferArena) {
+        FieldsBufferTimings localTimings{};
+        auto startTime = std::chrono::steady_clock::now();
+        auto arena = std::make_shared<BufferArena>(
+                device, sizeInBytes3D, cs, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
+        localTimings.allocationSeconds = getSecondsSince(startTime);
+        ctx.out
+                << "Buffer arena: " << cs << " members in " << arena->getNumMemoryBlocks() << " memory blocks ("
+                << sgl::getNiceMemoryString(arena->getAllocatedSizeInBytes(), 2) << ")" << std::endl;
+        // Aliasing pointers share the ownership of the arena, so it lives as long as any of its members is used.
+        std::vector<sgl::vk::BufferPtr> fieldBuffers;
+        for (const sgl::vk::BufferPtr& buffer : arena->getBuffers()) {
+            fieldBuffers.emplace_back(arena, buffer.get());
+        }
+        uploadFieldBuffersPattern(testSettings, ctx, fieldBuffers, numEntries3D, localTimings);
+        if (timings) {
+            *timings = localTimings;
+        }
+        return fieldBuffers;
+    }
+
+    auto* data = new float[numEntries3D];
+    FillStatistics fillStatistics = fillConstantPattern(data, numEntries3D, 7.0f, 0.0f);
+    printFillStatistics(ctx.out, fillStatistics);
+    auto startTime = std::chrono::steady_clock::now();
+    sgl::vk::BufferPtr fieldBuffer0(new sgl::vk::Buffer(
+            device, sizeInBytes3D, data,
+            VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+            VMA_MEMORY_USAGE_GPU_ONLY));
+    data[numEntries3D - 1] = 42.0f;
+    sgl::vk::BufferPtr fieldBuffer1(new sgl::vk::Buffer(
+            device, sizeInBytes3D, data,
+            VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+            VMA_MEMORY_USAGE_GPU_ONLY));
+    if (timings) {
+        timings->fillSeconds = fillStatistics.timeSeconds;
+        timings->uploadSeconds = getSecondsSince(startTime);
+    }
+    delete[] data;
+    std::vector<sgl::vk::BufferPtr> fieldBuffers;
+    for (uint32_t j = 0; j < cs - 1; j++) {
+        fieldBuffers.push_back(fieldBuffer0);
+    }
+    fieldBuffers.push_back(fieldBuffer1);
+    return fieldBuffers;
+}
+
+// The transfer source usage is needed for sampling generated buffers.
+static const VkBufferUsageFlags FIELDS_BUFFER_USAGE =
+        VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT
+        | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+
+/// Allocates a device-local fields buffer, either dedicated or backed by the memory blocks of a sparse buffer.
+static sgl::vk::BufferPtr allocateDeviceFieldsBuffer(
+        const TestSettings& testSettings, const TestContext& ctx, size_t sizeInBytes, VkBufferUsageFlags usage) {
+    if (!testSettings.useSparseBinding || !SparseBuffer::getIsSupported(ctx.device)) {
+        return std::make_shared<sgl::vk::Buffer>(ctx.device, sizeInBytes, usage, VMA_MEMORY_USAGE_GPU_ONLY);
+    }
+    auto sparseBuffer = std::make_shared<SparseBuffer>(
+            ctx.device, sizeInBytes, testSettings.sparseBlockSizeInBytes, usage);
+    ctx.out
+            << "Sparse buffer: " << sparseBuffer->getNumMemoryBlocks() << " blocks of "
+            << sgl::getNiceMemoryString(sparseBuffer->getBlockSizeInBytes(), 2) << ", bind "
+            << (sparseBuffer->getBindSeconds() * 1e3) << "ms" << std::endl;
+    // Like for arena members, the aliasing pointer keeps the memory blocks alive as long as the buffer is used.
+    return { sparseBuffer, sparseBuffer->getBuffer().get() };
+}
+
+sgl::vk::BufferPtr allocateFieldsBuffer(
+        const TestSettings& testSettings, const TestContext& ctx, size_t sizeInBytes, bool useHostAllocation) {
+    if (!useHostAllocation) {
+        return allocateDeviceFieldsBuffer(testSettings, ctx, sizeInBytes, FIELDS_BUFFER_USAGE);
+    }
+    auto fieldsBuffer = std::make_shared<sgl::vk::Buffer>(ctx.device);
+    if (!fieldsBuffer->allocateFromNewHostPointer(
+            sizeInBytes, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT)) {
+        sgl::Logfile::get()->throwError("Error in allocateFieldsBuffer: Could not import the host allocation.");
+    }
+    return fieldsBuffer;
+}
+
+sgl::vk::BufferPtr createFieldsBuffer(
+        const TestSettings& testSettings, const TestContext& ctx, TestDataType testDataType,
+        size_t numEntries, size_t sizeInBytes, bool useHostAllocation, void** hostPtrOut,
+        FieldsBufferTimings* timings) {
+    sgl::vk::Device* device = ctx.device;
+    const VkBufferUsageFlags fieldsBufferUsage = FIELDS_BUFFER_USAGE;
+    FieldsBufferTimings localTimings{};
+    sgl::vk::BufferPtr fieldsBuffer;
+    void* hostPtr = nullptr;
+    auto startTime = std::chrono::steady_clock::now();
+    if (!useHostAllocation && testSettings.useGpuGeneration) {
+        fieldsBuffer = allocateDeviceFieldsBuffer(testSettings, ctx, sizeInBytes, fieldsBufferUsage);
+        localTimings.allocationSeconds = getSecondsSince(startTime);
+        localTimings.fillSeconds = generateFieldsPattern(ctx, testDataType, fieldsBuffer, numEntries);
+        size_t numMismatches = verifyFieldsPattern(
+                ctx, testDataType, fieldsBuffer, numEntries, FIELDS_VERIFICATION_NUM_SAMPLES);
+        ctx.out
+                << "GPU generation: " << (localTimings.fillSeconds * 1e3) << "ms ("
+                << (double(sizeInBytes) / localTimings.fillSeconds * 1e-9) << " GB/s), "
+                << numMismatches << " of " << FIELDS_VERIFICATION_NUM_SAMPLES << " samples mismatching" << std::endl;
+        if (numMismatches != 0) {
+            sgl::Logfile::get()->writeError("Error in createFieldsBuffer: The generated fields buffer is incorrect.");
+        }
+    } else if (!useHostAllocation && testSettings.useStreamingUpload) {
+        fieldsBuffer = allocateDeviceFieldsBuffer(testSettings, ctx, sizeInBytes, fieldsBufferUsage);
+        localTimings.allocationSeconds = getSecondsSince(startTime);
+        StreamingUploader streamingUploader(
+                device, testSettings.streamingChunkSizeInBytes, testSettings.numStreamingChunks);
+        // The fill function is only called from the producer thread, which is joined before upload returns.
+        UploadStatistics uploadStatistics = streamingUploader.upload(
+                fieldsBuffer, [&](void* dst, size_t byteOffset, size_t byteSize) {
+            localTimings.fillSeconds += fillFieldsPattern(
+                    testDataType, numEntries, dst, byteOffset, byteSize).timeSeconds;
+        });
+        printUploadStatistics(ctx.out, uploadStatistics);
+        localTimings.uploadSeconds = uploadStatistics.timeSeconds;
+    } else if (useHostAllocation) {
+        // Check claims from https://community.khronos.org/t/memory-import-size-truncated-on-windows/111813.
+        // https://docs.vulkan.org/refpages/latest/refpages/source/VK_EXT_external_memory_host.html
+        fieldsBuffer = std::make_shared<sgl::vk::Buffer>(device);
+        hostPtr = fieldsBuffer->allocateFromNewHostPointer(
+                sizeInBytes, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT);
+        localTimings.allocationSeconds = getSecondsSince(startTime);
+    } else {
+        hostPtr = std::malloc(sizeInBytes);
+        localTimings.allocationSeconds = getSecondsSince(startTime);
+    }
+    if (hostPtr) {
+        FillStatistics fillStatistics = fillFieldsPattern(testDataType, numEntries, hostPtr, 0, sizeInBytes);
+        printFillStatistics(ctx.out, fillStatistics);
+        localTimings.fillSeconds = fillStatistics.timeSeconds;
+    }
+    if (!useHostAllocation && !testSettings.useStreamingUpload) {
+        startTime = std::chrono::steady_clock::now();
+        fieldsBuffer = std::make_shared<sgl::vk::Buffer>(
+                device, sizeInBytes, hostPtr, fieldsBufferUsage, VMA_MEMORY_USAGE_GPU_ONLY);
+        localTimings.uploadSeconds = getSecondsSince(startTime);
+        free(hostPtr);
+        hostPtr = nullptr;
+    }
+    if (hostPtrOut) {
+        *hostPtrOut = hostPtr;
+    }
+    if (timings) {
+        *timings = localTimings;
+    }
+    return fieldsBuffer;
+}
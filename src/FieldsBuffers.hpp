@@ -0,0 +1,92 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef BUFFERTEST64_FIELDSBUFFERS_HPP
+#define BUFFERTEST64_FIELDSBUFFERS_HPP
+
+#include <vector>
+
+#include <Graphics/Vulkan/Buffers/Buffer.hpp>
+
+#include "TestTypes.hpp"
+#include "ParallelFill.hpp"
+#include "Tests.hpp"
+
+/// Wall clock times of the creation steps. Steps that the sgl buffer constructor performs together count as upload.
+struct FieldsBufferTimings {
+    double allocationSeconds = 0.0;
+    double fillSeconds = 0.0;
+    double uploadSeconds = 0.0;
+};
+
+/**
+ * Writes the bytes [byteOffset, byteOffset + byteSize) of the fields buffer test pattern to dst using all cores.
+ * Every entry is written exactly once, so no memset is necessary beforehand.
+ */
+FillStatistics fillFieldsPattern(
+        TestDataType testDataType, size_t numEntries, void* dst, size_t byteOffset, size_t byteSize);
+
+/// Writes one entry with all components set to value, e.g., the value 42 expected at the end of the buffer.
+void writeDataTypeValue(TestDataType testDataType, void* dst, uint32_t value);
+/// Returns the value of the components of one entry, or NaN if the components of a vector type differ.
+double readDataTypeValue(TestDataType testDataType, const void* src);
+
+/**
+ * Creates the member buffers of the storage buffer array mode. By default, all but the last member share one buffer.
+ * With TestSettings::useBufferArena, all members are distinct buffers sub-allocated from a BufferArena, which is kept
+ * alive by the returned buffer pointers.
+ */
+std::vector<sgl::vk::BufferPtr> createFieldBuffers(
+        const TestSettings& testSettings, const TestContext& ctx, size_t numEntries3D, uint32_t cs,
+        FieldsBufferTimings* timings = nullptr);
+
+/**
+ * Uploads the storage buffer array pattern to distinct member buffers: All members contain 7 and a last entry of 0,
+ * except for the last member, whose last entry is 42. Adds the fill and upload times to timings.
+ */
+void uploadFieldBuffersPattern(
+        const TestSettings& testSettings, const TestContext& ctx, const std::vector<sgl::vk::BufferPtr>& fieldBuffers,
+        size_t numEntries3D, FieldsBufferTimings& timings);
+
+/**
+ * Allocates a fields buffer of the allocation kind like createFieldsBuffer, but does not fill it. Throws if the
+ * allocation fails, e.g., for probing the largest possible allocation.
+ */
+sgl::vk::BufferPtr allocateFieldsBuffer(
+        const TestSettings& testSettings, const TestContext& ctx, size_t sizeInBytes, bool useHostAllocation);
+
+/**
+ * Creates the fields buffer shared by all test modes not using a buffer array and fills it with the test pattern.
+ * For host allocations, the pointer to the imported host memory is returned in hostPtrOut (if not null).
+ */
+sgl::vk::BufferPtr createFieldsBuffer(
+        const TestSettings& testSettings, const TestContext& ctx, TestDataType testDataType,
+        size_t numEntries, size_t sizeInBytes, bool useHostAllocation, void** hostPtrOut = nullptr,
+        FieldsBufferTimings* timings = nullptr);
+
+#endif //BUFFERTEST64_FIELDSBUFFERS_HPP
@@ -0,0 +1,242 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include <Graphics/Vulkan/Utils/Device.hpp>
+#include <Graphics/Vulkan/Render/Renderer.hpp>
+
+#include "ShaderCache.hpp"
+#include "GpuTimer.hpp"
+#include "FieldsBuffers.hpp"
+#include "ComputeQueueSubmitter.hpp"
+#include "BufferTestComputePass.hpp"
+#include "Tests.hpp"
+#include "FieldsGeneratorPass.hpp"
+
+static const uint32_t GENERATOR_WORKGROUP_SIZE = 256;
+
+FieldsGeneratorPass::FieldsGeneratorPass(sgl::vk::Renderer* renderer, ShaderCache* shaderCache)
+        : ComputePass(renderer), shaderCache(shaderCache) {
+}
+
+void FieldsGeneratorPass::setDataType(TestDataType _dataType) {
+    dataType = _dataType;
+    setShaderDirty();
+}
+
+void FieldsGeneratorPass::setFieldsBuffer(const sgl::vk::BufferPtr& _fieldsBuffer, size_t _numEntries) {
+    fieldsBuffer = _fieldsBuffer;
+    numEntries = _numEntries;
+}
+
+void FieldsGeneratorPass::loadShader() {
+    std::map<std::string, std::string> preprocessorDefines;
+    std::vector<std::string> extensions;
+    addDataTypePreprocessorDefines(dataType, preprocessorDefines, extensions);
+    setExtensionsDefine(preprocessorDefines, extensions);
+    preprocessorDefines.insert(std::make_pair("BLOCK_SIZE", std::to_string(GENERATOR_WORKGROUP_SIZE)));
+    if (dataType == TestDataType::FLOAT) {
+        preprocessorDefines.insert(std::make_pair("INDEX_PATTERN", ""));
+    }
+    shaderStages = shaderCache->getShaderStages("GenerateBuffer.Compute", preprocessorDefines);
+}
+
+void FieldsGeneratorPass::createComputeData(
+        sgl::vk::Renderer* renderer, sgl::vk::ComputePipelinePtr& computePipeline) {
+    computeData = std::make_shared<sgl::vk::ComputeData>(renderer, computePipeline);
+}
+
+void FieldsGeneratorPass::_render() {
+    // Needs to match the layout of the push constant block in the shader.
+    struct PushConstants {
+        uint64_t fieldsAddress;
+        uint64_t numEntries;
+    };
+    PushConstants pushConstantsData{ fieldsBuffer->getVkDeviceAddress(), uint64_t(numEntries) };
+    renderer->pushConstants(computeData->getComputePipeline(), VK_SHADER_STAGE_COMPUTE_BIT, 0, pushConstantsData);
+    // The grid-stride loop covers the entries not reached by the limited number of work groups.
+    size_t numWorkgroups = (numEntries + GENERATOR_WORKGROUP_SIZE - 1) / GENERATOR_WORKGROUP_SIZE;
+    numWorkgroups = std::min(numWorkgroups, size_t(std::min(device->getLimits().maxComputeWorkGroupCount[0], 65535u)));
+    renderer->dispatch(computeData, uint32_t(numWorkgroups), 1, 1);
+}
+
+/**
+ * Returns true and sets fillWord if all entries except for the last one consist of one repeated 32-bit word, i.e., if
+ * the buffer can be written with vkCmdFillBuffer.
+ */
+static bool getConstantFillWord(TestDataType testDataType, size_t numEntries, uint32_t& fillWord) {
+    if (testDataType == TestDataType::FLOAT) {
+        return false;
+    }
+    const size_t entrySize = getTestDataTypeSize(testDataType);
+    if (numEntries * entrySize % sizeof(uint32_t) != 0) {
+        return false;
+    }
+    uint8_t entry[MAX_TEST_DATA_TYPE_SIZE];
+    writeDataTypeValue(testDataType, entry, 7);
+    uint8_t words[MAX_TEST_DATA_TYPE_SIZE];
+    const size_t patternSize = std::max(entrySize, sizeof(uint32_t));
+    for (size_t byteIdx = 0; byteIdx < patternSize; byteIdx++) {
+        words[byteIdx] = entry[byteIdx % entrySize];
+    }
+    std::memcpy(&fillWord, words, sizeof(uint32_t));
+    for (size_t byteIdx = sizeof(uint32_t); byteIdx < patternSize; byteIdx += sizeof(uint32_t)) {
+        if (std::memcmp(words, words + byteIdx, sizeof(uint32_t)) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+double generateFieldsPattern(
+        const TestContext& ctx, TestDataType testDataType, const sgl::vk::BufferPtr& fieldsBuffer, size_t numEntries) {
+    sgl::vk::Device* device = ctx.device;
+    ComputeQueueSubmitter submitter(device);
+    submitter.begin();
+    sgl::vk::Renderer* renderer = submitter.getRenderer();
+    VkCommandBuffer commandBuffer = submitter.getVkCommandBuffer();
+    GpuTimer gpuTimer(device, 1);
+    gpuTimer.reset(commandBuffer);
+    uint32_t intervalIdx = gpuTimer.begin(commandBuffer);
+
+    // Kept alive until the command buffer has finished executing.
+    std::shared_ptr<FieldsGeneratorPass> generatorPass;
+    uint32_t fillWord = 0;
+    if (getConstantFillWord(testDataType, numEntries, fillWord)) {
+        const size_t entrySize = getTestDataTypeSize(testDataType);
+        const size_t sizeInBytes = numEntries * entrySize;
+        vkCmdFillBuffer(commandBuffer, fieldsBuffer->getVkBuffer(), 0, sizeInBytes, fillWord);
+        // vkCmdUpdateBuffer needs a 4-byte aligned offset and size, so the word(s) holding the last entry are patched.
+        const size_t patchOffset = ((numEntries - 1) * entrySize) & ~size_t(3);
+        const size_t patchSize = sizeInBytes - patchOffset;
+        uint8_t patchData[MAX_TEST_DATA_TYPE_SIZE];
+        fillFieldsPattern(testDataType, numEntries, patchData, patchOffset, patchSize);
+        renderer->insertBufferMemoryBarrier(
+                VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
+                VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                fieldsBuffer);
+        vkCmdUpdateBuffer(commandBuffer, fieldsBuffer->getVkBuffer(), patchOffset, patchSize, patchData);
+    } else {
+        generatorPass = std::make_shared<FieldsGeneratorPass>(renderer, ctx.shaderCache);
+        generatorPass->setDataType(testDataType);
+        generatorPass->setFieldsBuffer(fieldsBuffer, numEntries);
+        generatorPass->render();
+    }
+    // Makes the pattern visible to the test passes recorded into later command buffers.
+    renderer->insertBufferMemoryBarrier(
+            VK_ACCESS_TRANSFER_WRITE_BIT | VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT,
+            VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            fieldsBuffer);
+    gpuTimer.end(commandBuffer, intervalIdx);
+    submitter.submitAndWait();
+
+    std::vector<double> elapsedTimes = gpuTimer.getElapsedTimesSeconds();
+    return elapsedTimes.empty() ? 0.0 : elapsedTimes.front();
+}
+
+bool getIsIndexPatternValueValid(float value, size_t entryIdx) {
+    // Values of 2^64 and above can't be converted to uint64_t.
+    if (!std::isfinite(value) || value < 0.0f || value >= 18446744073709551616.0f || std::floor(value) != value) {
+        return false;
+    }
+    auto valueIdx = uint64_t(value);
+    uint64_t ulp = 0;
+    if (entryIdx >= (size_t(1) << size_t(24))) {
+        int exponent = 24;
+        while ((uint64_t(entryIdx) >> uint64_t(exponent + 1)) != 0) {
+            exponent++;
+        }
+        ulp = uint64_t(1) << uint64_t(exponent - 23);
+    }
+    uint64_t difference = valueIdx > entryIdx ? valueIdx - entryIdx : entryIdx - valueIdx;
+    return difference <= ulp;
+}
+
+size_t verifyFieldsPattern(
+        const TestContext& ctx, TestDataType testDataType, const sgl::vk::BufferPtr& fieldsBuffer, size_t numEntries,
+        size_t numSamples) {
+    sgl::vk::Device* device = ctx.device;
+    const size_t entrySize = getTestDataTypeSize(testDataType);
+
+    // The 32-bit address math of the test modes wraps around at 4 GiB, so the entries around these boundaries are the
+    // most likely ones to be written to the wrong place. The remaining samples are spread with a fixed LCG.
+    std::vector<size_t> sampleIndices = { 0, numEntries - 1 };
+    const size_t entriesPer4GiB = (size_t(1) << size_t(32)) / entrySize;
+    for (size_t boundary = entriesPer4GiB; boundary < numEntries; boundary += entriesPer4GiB) {
+        sampleIndices.push_back(boundary - 1);
+        sampleIndices.push_back(boundary);
+    }
+    uint64_t lcgState = 1;
+    while (sampleIndices.size() < numSamples) {
+        lcgState = lcgState * 6364136223846793005ull + 1442695040888963407ull;
+        sampleIndices.push_back(size_t((lcgState >> 16) % uint64_t(numEntries)));
+    }
+
+    std::vector<VkBufferCopy> copyRegions(sampleIndices.size());
+    for (size_t sampleIdx = 0; sampleIdx < sampleIndices.size(); sampleIdx++) {
+        copyRegions.at(sampleIdx).srcOffset = sampleIndices.at(sampleIdx) * entrySize;
+        copyRegions.at(sampleIdx).dstOffset = sampleIdx * entrySize;
+        copyRegions.at(sampleIdx).size = entrySize;
+    }
+    auto stagingBuffer = std::make_shared<sgl::vk::Buffer>(
+            device, sampleIndices.size() * entrySize, VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            VMA_MEMORY_USAGE_GPU_TO_CPU);
+    ComputeQueueSubmitter submitter(device);
+    submitter.begin();
+    submitter.getRenderer()->insertBufferMemoryBarrier(
+            VK_ACCESS_TRANSFER_WRITE_BIT | VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT,
+            VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+            fieldsBuffer);
+    vkCmdCopyBuffer(
+            submitter.getVkCommandBuffer(), fieldsBuffer->getVkBuffer(), stagingBuffer->getVkBuffer(),
+            uint32_t(copyRegions.size()), copyRegions.data());
+    submitter.submitAndWait();
+
+    size_t numMismatches = 0;
+    auto* sampleData = static_cast<const uint8_t*>(stagingBuffer->mapMemory());
+    uint8_t expectedEntry[MAX_TEST_DATA_TYPE_SIZE];
+    for (size_t sampleIdx = 0; sampleIdx < sampleIndices.size(); sampleIdx++) {
+        const size_t entryIdx = sampleIndices.at(sampleIdx);
+        if (testDataType == TestDataType::FLOAT && entryIdx != numEntries - 1) {
+            float value;
+            std::memcpy(&value, sampleData + sampleIdx * entrySize, sizeof(float));
+            if (!getIsIndexPatternValueValid(value, entryIdx)) {
+                numMismatches++;
+            }
+            continue;
+        }
+        fillFieldsPattern(testDataType, numEntries, expectedEntry, entryIdx * entrySize, entrySize);
+        if (std::memcmp(sampleData + sampleIdx * entrySize, expectedEntry, entrySize) != 0) {
+            numMismatches++;
+        }
+    }
+    stagingBuffer->unmapMemory();
+    return numMismatches;
+}
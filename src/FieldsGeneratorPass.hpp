@@ -0,0 +1,85 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef BUFFERTEST64_FIELDSGENERATORPASS_HPP
+#define BUFFERTEST64_FIELDSGENERATORPASS_HPP
+
+#include <Graphics/Vulkan/Buffers/Buffer.hpp>
+#include <Graphics/Vulkan/Render/Passes/Pass.hpp>
+
+#include "TestTypes.hpp"
+
+class ShaderCache;
+struct TestContext;
+
+/**
+ * Writes the fields buffer test pattern (see fillFieldsPattern) directly on the GPU. The buffer is addressed through
+ * its device address, so it may exceed the maximum storage buffer range.
+ */
+class FieldsGeneratorPass : public sgl::vk::ComputePass {
+public:
+    FieldsGeneratorPass(sgl::vk::Renderer* renderer, ShaderCache* shaderCache);
+    void setDataType(TestDataType _dataType);
+    void setFieldsBuffer(const sgl::vk::BufferPtr& _fieldsBuffer, size_t _numEntries);
+
+protected:
+    void loadShader() override;
+    void createComputeData(sgl::vk::Renderer* renderer, sgl::vk::ComputePipelinePtr& computePipeline) override;
+    void _render() override;
+
+private:
+    ShaderCache* shaderCache;
+    TestDataType dataType = TestDataType::FLOAT;
+    sgl::vk::BufferPtr fieldsBuffer;
+    size_t numEntries = 0;
+};
+
+/**
+ * Writes the test pattern to a device-local fields buffer without a host copy. Types whose repeated value 7 is a
+ * repeated 32-bit word are written with vkCmdFillBuffer and vkCmdUpdateBuffer, the float index pattern and uint64_t
+ * with a FieldsGeneratorPass. Returns the GPU time in seconds.
+ */
+double generateFieldsPattern(
+        const TestContext& ctx, TestDataType testDataType, const sgl::vk::BufferPtr& fieldsBuffer, size_t numEntries);
+
+/**
+ * Checks a float entry of the index pattern except for the last entry. The generator shader converts the 64-bit
+ * entry index to float on the GPU, which may round differently than the CPU above 2^24. Thus, the value is compared in
+ * integer space and may differ by one unit in the last place of the index.
+ */
+bool getIsIndexPatternValueValid(float value, size_t entryIdx);
+
+/**
+ * Reads back numSamples entries of a generated fields buffer, including the first and last entry and the entries
+ * around every 4 GiB boundary, and compares them with the pattern computed on the host. Returns the number of
+ * mismatching samples.
+ */
+size_t verifyFieldsPattern(
+        const TestContext& ctx, TestDataType testDataType, const sgl::vk::BufferPtr& fieldsBuffer, size_t numEntries,
+        size_t numSamples);
+
+#endif //BUFFERTEST64_FIELDSGENERATORPASS_HPP
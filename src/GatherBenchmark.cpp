@@ -0,0 +1,128 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <iomanip>
+#include <algorithm>
+
+#include <Graphics/Vulkan/Buffers/Buffer.hpp>
+#include <ImGui/Widgets/NumberFormatting.hpp>
+
+#include "FieldsBuffers.hpp"
+#include "ReadBandwidthMeter.hpp"
+#include "BufferGatherComputePass.hpp"
+#include "GatherBenchmark.hpp"
+
+// 5GiB of float entries, so the flat modes need more than 32 bits for the byte offset.
+static const uint32_t GATHER_XS = 512;
+static const uint32_t GATHER_YS = 512;
+static const uint32_t GATHER_ZS = 512;
+static const uint32_t GATHER_CS = 10;
+
+void runGatherBenchmark(const TestSettings& testSettings, const TestContext& ctx) {
+    sgl::vk::Device* device = ctx.device;
+    const size_t numEntries3D = size_t(GATHER_XS) * size_t(GATHER_YS) * size_t(GATHER_ZS);
+    const size_t numEntries = numEntries3D * size_t(GATHER_CS);
+    const size_t sizeInBytes = numEntries * sizeof(float);
+    ctx.out << std::endl;
+    ctx.out << "Gather benchmark: " << sgl::getNiceMemoryString(sizeInBytes, 2) << ", type float" << std::endl;
+
+    std::vector<TestMode> testModes;
+    for (int i = 0; i < NUM_TESTS; i++) {
+        if (!device->getShader64BitIndexingFeaturesEXT().shader64BitIndexing
+                && i >= int(TestMode::STORAGE_BUFFER_64_BIT)) {
+            break;
+        }
+        if (testSettings.testPlan.getIsTestModeSelected(TestMode(i))) {
+            testModes.push_back(TestMode(i));
+        }
+    }
+
+    std::vector<sgl::vk::BufferPtr> fieldBuffers = createFieldBuffers(testSettings, ctx, numEntries3D, GATHER_CS);
+    sgl::vk::BufferPtr fieldsBuffer = createFieldsBuffer(
+            testSettings, ctx, TestDataType::FLOAT, numEntries, sizeInBytes, false);
+
+    uint32_t numIterations = std::max(testSettings.benchmarkNumIterations, 1u);
+    ReadBandwidthMeter meter(device, numIterations);
+    std::vector<std::shared_ptr<BufferGatherComputePass>> passes;
+    for (TestMode testMode : testModes) {
+        auto pass = std::make_shared<BufferGatherComputePass>(
+                meter.getRenderer(), ctx.shaderCache, GATHER_XS, GATHER_YS, GATHER_ZS, GATHER_CS,
+                testSettings.benchmarkWorkgroupSize);
+        pass->setTestMode(testMode);
+        pass->setDataType(TestDataType::FLOAT);
+        pass->setOutputBuffer(meter.getOutputBuffer(), 0);
+        if (TEST_MODE_USES_ARRAY[int(testMode)]) {
+            pass->setFieldBuffers(fieldBuffers);
+        } else {
+            pass->setFieldsBuffer(fieldsBuffer);
+        }
+        passes.push_back(pass);
+    }
+
+    for (int patternIdx = 0; patternIdx < NUM_GATHER_PATTERNS; patternIdx++) {
+        ctx.out << std::endl;
+        ctx.out << "Gather pattern: " << GATHER_PATTERN_NAMES[patternIdx] << std::endl;
+        ctx.out
+                << std::left << std::setw(34) << "Test mode" << std::right << std::setw(12) << "Time [ms]"
+                << std::setw(14) << "Ggathers/s" << std::setw(12) << "vs. array" << std::setw(12) << "Mismatches"
+                << std::endl;
+        std::vector<double> gathersPerSecond(testModes.size(), 0.0);
+        std::vector<ReadMeasurement> measurements;
+        double arrayGathersPerSecond = 0.0;
+        for (size_t modeIdx = 0; modeIdx < testModes.size(); modeIdx++) {
+            BufferGatherComputePass* pass = passes.at(modeIdx).get();
+            pass->setGatherPattern(GatherPattern(patternIdx));
+            measurements.push_back(meter.measure(pass));
+            if (measurements.back().readSeconds > 0.0) {
+                gathersPerSecond.at(modeIdx) = double(pass->getNumGathers()) / measurements.back().readSeconds;
+            }
+            if (testModes.at(modeIdx) == TestMode::STORAGE_BUFFER_ARRAY) {
+                arrayGathersPerSecond = gathersPerSecond.at(modeIdx);
+            }
+        }
+        for (size_t modeIdx = 0; modeIdx < testModes.size(); modeIdx++) {
+            const ReadMeasurement& measurement = measurements.at(modeIdx);
+            ctx.out << std::left << std::setw(34) << TEST_MODE_NAMES[int(testModes.at(modeIdx))] << std::right;
+            ctx.out << std::fixed << std::setprecision(2);
+            if (gathersPerSecond.at(modeIdx) > 0.0) {
+                ctx.out << std::setw(12) << (measurement.readSeconds * 1e3);
+                ctx.out << std::setw(14) << (gathersPerSecond.at(modeIdx) * 1e-9);
+            } else {
+                ctx.out << std::setw(12) << "-" << std::setw(14) << "-";
+            }
+            if (gathersPerSecond.at(modeIdx) > 0.0 && arrayGathersPerSecond > 0.0) {
+                ctx.out << std::setw(12) << (gathersPerSecond.at(modeIdx) / arrayGathersPerSecond);
+            } else {
+                ctx.out << std::setw(12) << "-";
+            }
+            ctx.out << std::setw(12) << measurement.numMismatches << std::endl;
+            ctx.out.unsetf(std::ios_base::floatfield);
+            ctx.out << std::setprecision(6);
+        }
+    }
+}
@@ -0,0 +1,156 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <Utils/File/Logfile.hpp>
+
+#include "GpuTimer.hpp"
+
+GpuTimer::GpuTimer(sgl::vk::Device* device, uint32_t maxNumIntervals)
+        : device(device), maxNumIntervals(maxNumIntervals) {
+    uint32_t queueFamilyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(device->getVkPhysicalDevice(), &queueFamilyCount, nullptr);
+    std::vector<VkQueueFamilyProperties> queueFamilyProperties(queueFamilyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(
+            device->getVkPhysicalDevice(), &queueFamilyCount, queueFamilyProperties.data());
+    uint32_t timestampValidBits = queueFamilyProperties.at(device->getComputeQueueIndex()).timestampValidBits;
+    isSupported = timestampValidBits != 0;
+    if (!isSupported) {
+        return;
+    }
+    if (timestampValidBits < 64) {
+        timestampMask = (uint64_t(1) << uint64_t(timestampValidBits)) - uint64_t(1);
+    }
+    timestampPeriodNs = double(device->getLimits().timestampPeriod);
+
+    VkQueryPoolCreateInfo queryPoolCreateInfo{};
+    queryPoolCreateInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    queryPoolCreateInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+    queryPoolCreateInfo.queryCount = maxNumIntervals * 2;
+    if (vkCreateQueryPool(device->getVkDevice(), &queryPoolCreateInfo, nullptr, &queryPool) != VK_SUCCESS) {
+        sgl::Logfile::get()->throwError("Error in GpuTimer::GpuTimer: Could not create a query pool.");
+    }
+
+    if (device->getPhysicalDeviceFeatures().pipelineStatisticsQuery) {
+        VkQueryPoolCreateInfo statisticsQueryPoolCreateInfo{};
+        statisticsQueryPoolCreateInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        statisticsQueryPoolCreateInfo.queryType = VK_QUERY_TYPE_PIPELINE_STATISTICS;
+        statisticsQueryPoolCreateInfo.queryCount = maxNumIntervals;
+        statisticsQueryPoolCreateInfo.pipelineStatistics =
+                VK_QUERY_PIPELINE_STATISTIC_COMPUTE_SHADER_INVOCATIONS_BIT;
+        if (vkCreateQueryPool(
+                device->getVkDevice(), &statisticsQueryPoolCreateInfo, nullptr,
+                &pipelineStatisticsQueryPool) != VK_SUCCESS) {
+            sgl::Logfile::get()->writeError(
+                    "Error in GpuTimer::GpuTimer: Could not create a pipeline statistics query pool.");
+            pipelineStatisticsQueryPool = VK_NULL_HANDLE;
+        }
+    }
+}
+
+GpuTimer::~GpuTimer() {
+    if (queryPool) {
+        vkDestroyQueryPool(device->getVkDevice(), queryPool, nullptr);
+        queryPool = VK_NULL_HANDLE;
+    }
+    if (pipelineStatisticsQueryPool) {
+        vkDestroyQueryPool(device->getVkDevice(), pipelineStatisticsQueryPool, nullptr);
+        pipelineStatisticsQueryPool = VK_NULL_HANDLE;
+    }
+}
+
+void GpuTimer::reset(VkCommandBuffer commandBuffer) {
+    numIntervals = 0;
+    if (isSupported) {
+        vkCmdResetQueryPool(commandBuffer, queryPool, 0, maxNumIntervals * 2);
+    }
+    if (pipelineStatisticsQueryPool) {
+        vkCmdResetQueryPool(commandBuffer, pipelineStatisticsQueryPool, 0, maxNumIntervals);
+    }
+}
+
+uint32_t GpuTimer::begin(VkCommandBuffer commandBuffer) {
+    if (numIntervals >= maxNumIntervals) {
+        sgl::Logfile::get()->throwError("Error in GpuTimer::begin: Exceeded the maximum number of intervals.");
+    }
+    uint32_t intervalIdx = numIntervals++;
+    if (isSupported) {
+        vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, queryPool, intervalIdx * 2);
+    }
+    if (pipelineStatisticsQueryPool) {
+        vkCmdBeginQuery(commandBuffer, pipelineStatisticsQueryPool, intervalIdx, 0);
+    }
+    return intervalIdx;
+}
+
+void GpuTimer::end(VkCommandBuffer commandBuffer, uint32_t intervalIdx) {
+    if (pipelineStatisticsQueryPool) {
+        vkCmdEndQuery(commandBuffer, pipelineStatisticsQueryPool, intervalIdx);
+    }
+    if (isSupported) {
+        vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, queryPool, intervalIdx * 2 + 1);
+    }
+}
+
+std::vector<double> GpuTimer::getElapsedTimesSeconds() {
+    std::vector<double> elapsedTimes;
+    if (!isSupported || numIntervals == 0) {
+        return elapsedTimes;
+    }
+    std::vector<uint64_t> timestamps(numIntervals * 2);
+    VkResult result = vkGetQueryPoolResults(
+            device->getVkDevice(), queryPool, 0, numIntervals * 2, timestamps.size() * sizeof(uint64_t),
+            timestamps.data(), sizeof(uint64_t), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
+    if (result != VK_SUCCESS) {
+        sgl::Logfile::get()->writeError("Error in GpuTimer::getElapsedTimesSeconds: Could not get query results.");
+        return elapsedTimes;
+    }
+    elapsedTimes.reserve(numIntervals);
+    for (uint32_t intervalIdx = 0; intervalIdx < numIntervals; intervalIdx++) {
+        uint64_t ticks = ((timestamps[intervalIdx * 2 + 1] & timestampMask)
+                - (timestamps[intervalIdx * 2] & timestampMask)) & timestampMask;
+        elapsedTimes.push_back(double(ticks) * timestampPeriodNs * 1e-9);
+    }
+    return elapsedTimes;
+}
+
+std::vector<uint64_t> GpuTimer::getComputeShaderInvocations() {
+    std::vector<uint64_t> invocations;
+    if (!pipelineStatisticsQueryPool || numIntervals == 0) {
+        return invocations;
+    }
+    invocations.resize(numIntervals);
+    VkResult result = vkGetQueryPoolResults(
+            device->getVkDevice(), pipelineStatisticsQueryPool, 0, numIntervals, invocations.size() * sizeof(uint64_t),
+            invocations.data(), sizeof(uint64_t), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
+    if (result != VK_SUCCESS) {
+        sgl::Logfile::get()->writeError(
+                "Error in GpuTimer::getComputeShaderInvocations: Could not get query results.");
+        invocations.clear();
+    }
+    return invocations;
+}
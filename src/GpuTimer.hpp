@@ -0,0 +1,73 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef BUFFERTEST64_GPUTIMER_HPP
+#define BUFFERTEST64_GPUTIMER_HPP
+
+#include <vector>
+
+#include <Graphics/Vulkan/Utils/Device.hpp>
+
+/**
+ * Measures GPU time intervals with vkCmdWriteTimestamp. Each interval uses two queries of a timestamp query pool.
+ * Timestamps are written at the bottom of the pipe, so an interval starts when all previously recorded commands are
+ * done executing. If the device supports pipeline statistics queries, each interval also counts the compute shader
+ * invocations of the commands recorded between begin and end. Intervals must not be nested in that case.
+ */
+class GpuTimer {
+public:
+    GpuTimer(sgl::vk::Device* device, uint32_t maxNumIntervals);
+    ~GpuTimer();
+
+    /// Whether the compute queue supports timestamps at all (i.e., timestampValidBits != 0).
+    [[nodiscard]] inline bool getIsSupported() const { return isSupported; }
+
+    /// Resets all intervals. Needs to be recorded before the first call to begin.
+    void reset(VkCommandBuffer commandBuffer);
+    /// Returns the index of the started interval.
+    uint32_t begin(VkCommandBuffer commandBuffer);
+    void end(VkCommandBuffer commandBuffer, uint32_t intervalIdx);
+
+    /// Waits until the results are available and returns the elapsed time of all intervals in seconds.
+    std::vector<double> getElapsedTimesSeconds();
+    [[nodiscard]] inline bool getHasPipelineStatistics() const { return pipelineStatisticsQueryPool != VK_NULL_HANDLE; }
+    /// Waits until the results are available and returns the compute shader invocations of all intervals.
+    std::vector<uint64_t> getComputeShaderInvocations();
+
+private:
+    sgl::vk::Device* device;
+    bool isSupported = false;
+    uint32_t maxNumIntervals;
+    uint32_t numIntervals = 0;
+    uint64_t timestampMask = ~uint64_t(0);
+    double timestampPeriodNs = 1.0;
+    VkQueryPool queryPool = VK_NULL_HANDLE;
+    VkQueryPool pipelineStatisticsQueryPool = VK_NULL_HANDLE;
+};
+
+#endif //BUFFERTEST64_GPUTIMER_HPP
@@ -0,0 +1,192 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+
+#include <Graphics/Vulkan/Buffers/Buffer.hpp>
+#include <ImGui/Widgets/NumberFormatting.hpp>
+
+#include "Timing.hpp"
+#include "FieldsBuffers.hpp"
+#include "ReadBandwidthMeter.hpp"
+#include "HostMemory.hpp"
+#include "BufferBenchmarkComputePass.hpp"
+#include "HostImportBenchmark.hpp"
+
+static const uint32_t IMPORT_XS = 512;
+static const uint32_t IMPORT_YS = 512;
+static const uint32_t IMPORT_ZS = 16;
+static const size_t IMPORT_SLICE_ENTRIES = size_t(IMPORT_XS) * size_t(IMPORT_YS) * size_t(IMPORT_ZS);
+
+/// Prints one row of the comparison table. Setup is the time until the data is ready for the GPU to read.
+static void printRow(
+        std::ostream& out, const std::string& name, size_t sizeInBytes, double setupSeconds,
+        const ReadMeasurement& measurement, const std::string& comment) {
+    out << std::left << std::setw(40) << name << std::right << std::fixed << std::setprecision(2);
+    out << std::setw(12) << (setupSeconds * 1e3);
+    if (measurement.readSeconds > 0.0) {
+        out << std::setw(12) << (measurement.readSeconds * 1e3);
+        out << std::setw(12) << (double(sizeInBytes) / measurement.readSeconds * 1e-9);
+    } else {
+        out << std::setw(12) << "-" << std::setw(12) << "-";
+    }
+    out << std::setw(12) << measurement.numMismatches << "  " << comment << std::endl;
+    out.unsetf(std::ios_base::floatfield);
+    out << std::setprecision(6);
+}
+
+/**
+ * Returns a description of up to how many full reads zero-copy access is faster than uploading the data first, i.e.,
+ * solves hostSetup + n * hostRead = deviceSetup + n * deviceRead for n.
+ */
+static std::string getBreakEvenString(
+        double hostSetupSeconds, const ReadMeasurement& hostRead,
+        double deviceSetupSeconds, const ReadMeasurement& deviceRead) {
+    if (hostRead.readSeconds <= 0.0 || deviceRead.readSeconds <= 0.0) {
+        return {};
+    }
+    double setupDifference = deviceSetupSeconds - hostSetupSeconds;
+    double readDifference = hostRead.readSeconds - deviceRead.readSeconds;
+    // Zero-copy is faster for n reads if n * readDifference < setupDifference.
+    if (readDifference == 0.0) {
+        return setupDifference > 0.0 ? "zero-copy always faster" : "zero-copy never faster";
+    }
+    if (readDifference < 0.0) {
+        if (setupDifference >= 0.0) {
+            return "zero-copy always faster";
+        }
+        // Slower set-up, but faster reads; both differences are negative.
+        return "zero-copy faster after " + std::to_string(uint64_t(setupDifference / readDifference)) + " reads";
+    }
+    if (setupDifference <= 0.0) {
+        return "zero-copy never faster";
+    }
+    return "zero-copy faster for up to " + std::to_string(uint64_t(setupDifference / readDifference)) + " reads";
+}
+
+static void benchmarkDataType(const TestSettings& testSettings, const TestContext& ctx, TestDataType testDataType) {
+    sgl::vk::Device* device = ctx.device;
+    const size_t dataTypeSize = getTestDataTypeSize(testDataType);
+    const size_t sliceSizeInBytes = IMPORT_SLICE_ENTRIES * dataTypeSize;
+    const auto cs = uint32_t(std::max(testSettings.hostImportSizeInBytes / sliceSizeInBytes, size_t(1)));
+    const size_t sizeInBytes = size_t(cs) * sliceSizeInBytes;
+    const size_t numEntries = sizeInBytes / dataTypeSize;
+    ctx.out << std::endl;
+    ctx.out
+            << "Host import benchmark: " << sgl::getNiceMemoryString(sizeInBytes, 2)
+            << ", type " << TEST_DATA_TYPE_NAMES[int(testDataType)] << std::endl;
+
+    uint32_t numIterations = std::max(testSettings.benchmarkNumIterations, 1u);
+    ReadBandwidthMeter meter(device, numIterations);
+    // The buffer reference array mode reads through a raw device address, which also works for imported memory.
+    auto pass = std::make_shared<BufferBenchmarkComputePass>(
+            meter.getRenderer(), ctx.shaderCache, IMPORT_XS, IMPORT_YS, IMPORT_ZS, cs,
+            testSettings.benchmarkWorkgroupSize);
+    pass->setTestMode(TestMode::BUFFER_REFERENCE_ARRAY);
+    pass->setDataType(testDataType);
+    pass->setOutputBuffer(meter.getOutputBuffer(), 0);
+
+    // Reference: upload to a device-local buffer first.
+    FieldsBufferTimings timings{};
+    TestSettings uploadSettings = testSettings;
+    uploadSettings.useStreamingUpload = true;
+    uploadSettings.useGpuGeneration = false;
+    sgl::vk::BufferPtr deviceBuffer = createFieldsBuffer(
+            uploadSettings, ctx, testDataType, numEntries, sizeInBytes, false, nullptr, &timings);
+    pass->setFieldsBuffer(deviceBuffer);
+    ReadMeasurement deviceRead = meter.measure(pass.get());
+    // The streaming upload fills the staging chunks on the host while copying, so the fill time is included.
+    double deviceSetupSeconds = timings.allocationSeconds + timings.uploadSeconds;
+
+    ctx.out
+            << std::left << std::setw(40) << "Variant" << std::right << std::setw(12) << "Setup [ms]"
+            << std::setw(12) << "Read [ms]" << std::setw(12) << "GB/s" << std::setw(12) << "Mismatches" << std::endl;
+    printRow(ctx.out, "device-local copy", sizeInBytes, deviceSetupSeconds, deviceRead, "");
+
+    std::vector<size_t> pointerAlignments;
+    const size_t minAlignment = device->getMinImportedHostPointerAlignment();
+    if (minAlignment >= 128) {
+        // Expected to fail; shows whether the driver enforces the reported alignment.
+        pointerAlignments.push_back(minAlignment / 2);
+    }
+    pointerAlignments.push_back(minAlignment);
+    if (minAlignment < size_t(64 * 1024)) {
+        pointerAlignments.push_back(size_t(64 * 1024));
+    }
+    pointerAlignments.push_back(0);
+
+    for (int pageTypeIdx = 0; pageTypeIdx < NUM_HOST_PAGE_TYPES; pageTypeIdx++) {
+        auto pageType = HostPageType(pageTypeIdx);
+        for (size_t pointerAlignment : pointerAlignments) {
+            std::string name = std::string(HOST_PAGE_TYPE_NAMES[pageTypeIdx]) + ", align ";
+            name += pointerAlignment == 0 ? "2MiB" : sgl::getNiceMemoryString(pointerAlignment, 2);
+            HostMemory hostMemory(pageType, sizeInBytes, pointerAlignment);
+            if (!hostMemory.getIsValid()) {
+                printRow(ctx.out, name, sizeInBytes, 0.0, {}, "not supported");
+                continue;
+            }
+            FillStatistics fillStatistics = fillFieldsPattern(
+                    testDataType, numEntries, hostMemory.getData(), 0, sizeInBytes);
+            auto startTime = std::chrono::steady_clock::now();
+            std::unique_ptr<HostImportedBuffer> importedBuffer;
+            try {
+                importedBuffer = std::make_unique<HostImportedBuffer>(device, hostMemory.getData(), sizeInBytes);
+            } catch (const std::exception& e) {
+                printRow(ctx.out, name, sizeInBytes, 0.0, {}, std::string("import failed: ") + e.what());
+                continue;
+            }
+            double importSeconds = getSecondsSince(startTime);
+            pass->setFieldsDeviceAddress(importedBuffer->getVkDeviceAddress());
+            ReadMeasurement hostRead = meter.measure(pass.get());
+            pass->setFieldsDeviceAddress(0);
+            double hostSetupSeconds = fillStatistics.timeSeconds + importSeconds;
+            std::string comment =
+                    "import " + std::to_string(importSeconds * 1e3) + "ms, "
+                    + getBreakEvenString(hostSetupSeconds, hostRead, deviceSetupSeconds, deviceRead);
+            printRow(ctx.out, name, sizeInBytes, hostSetupSeconds, hostRead, comment);
+        }
+    }
+}
+
+void runHostImportBenchmark(const TestSettings& testSettings, const TestContext& ctx) {
+    sgl::vk::Device* device = ctx.device;
+    if (!device->isDeviceExtensionEnabled(VK_EXT_EXTERNAL_MEMORY_HOST_EXTENSION_NAME)) {
+        ctx.out << "Host import benchmark: VK_EXT_external_memory_host is not supported." << std::endl;
+        return;
+    }
+    for (int testDataTypeIdx = 0; testDataTypeIdx < NUM_TEST_DATA_TYPES; testDataTypeIdx++) {
+        auto testDataType = TestDataType(testDataTypeIdx);
+        if (!testSettings.testPlan.getIsDataTypeSelected(testDataType)
+                || !getIsTestDataTypeSupported(device, testDataType)) {
+            continue;
+        }
+        benchmarkDataType(testSettings, ctx, testDataType);
+    }
+}
@@ -0,0 +1,190 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "HostMemory.hpp"
+
+static const size_t HUGE_PAGE_SIZE = size_t(2) * size_t(1024) * size_t(1024);
+
+static size_t alignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+HostMemory::HostMemory(HostPageType pageType, size_t sizeInBytes, size_t pointerAlignment)
+        : pageType(pageType), sizeInBytes(sizeInBytes) {
+    // Reserve one additional huge page, so the offset pointer still covers sizeInBytes.
+    mappingSizeInBytes = alignUp(sizeInBytes + pointerAlignment, HUGE_PAGE_SIZE);
+    if (pageType == HostPageType::REGULAR) {
+#if defined(_WIN32)
+        base = _aligned_malloc(mappingSizeInBytes, HUGE_PAGE_SIZE);
+#else
+        if (posix_memalign(&base, HUGE_PAGE_SIZE, mappingSizeInBytes) != 0) {
+            base = nullptr;
+        }
+#endif
+    }
+#if defined(__linux__)
+    else if (pageType == HostPageType::TRANSPARENT_HUGE_PAGES) {
+        if (posix_memalign(&base, HUGE_PAGE_SIZE, mappingSizeInBytes) != 0) {
+            base = nullptr;
+        } else {
+            // Only a hint; whether huge pages are used depends on /sys/kernel/mm/transparent_hugepage/enabled.
+            madvise(base, mappingSizeInBytes, MADV_HUGEPAGE);
+        }
+    } else if (pageType == HostPageType::MEMFD || pageType == HostPageType::MEMFD_HUGETLB) {
+        unsigned int flags = 0;
+        if (pageType == HostPageType::MEMFD_HUGETLB) {
+#ifdef MFD_HUGETLB
+            flags |= MFD_HUGETLB;
+#else
+            return;
+#endif
+        }
+        fd = memfd_create("BufferTest64", flags);
+        if (fd < 0) {
+            return;
+        }
+        if (ftruncate(fd, off_t(mappingSizeInBytes)) != 0) {
+            return;
+        }
+        void* mapping = mmap(nullptr, mappingSizeInBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (mapping == MAP_FAILED) {
+            return;
+        }
+        base = mapping;
+    }
+#endif
+    if (base) {
+        data = static_cast<uint8_t*>(base) + pointerAlignment;
+    }
+}
+
+HostMemory::~HostMemory() {
+    if (pageType == HostPageType::REGULAR || pageType == HostPageType::TRANSPARENT_HUGE_PAGES) {
+#if defined(_WIN32)
+        _aligned_free(base);
+#else
+        free(base);
+#endif
+    }
+#if defined(__linux__)
+    else {
+        if (base) {
+            munmap(base, mappingSizeInBytes);
+        }
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+#endif
+}
+
+HostImportedBuffer::HostImportedBuffer(sgl::vk::Device* device, void* hostPtr, size_t sizeInBytes) : device(device) {
+    VkDevice vkDevice = device->getVkDevice();
+    auto pVkGetMemoryHostPointerPropertiesEXT = reinterpret_cast<PFN_vkGetMemoryHostPointerPropertiesEXT>(
+            vkGetDeviceProcAddr(vkDevice, "vkGetMemoryHostPointerPropertiesEXT"));
+    if (!pVkGetMemoryHostPointerPropertiesEXT) {
+        throw std::runtime_error("VK_EXT_external_memory_host is not available.");
+    }
+    VkMemoryHostPointerPropertiesEXT hostPointerProperties{};
+    hostPointerProperties.sType = VK_STRUCTURE_TYPE_MEMORY_HOST_POINTER_PROPERTIES_EXT;
+    VkResult result = pVkGetMemoryHostPointerPropertiesEXT(
+            vkDevice, VK_EXTERNAL_MEMORY_HANDLE_TYPE_HOST_ALLOCATION_BIT_EXT, hostPtr, &hostPointerProperties);
+    if (result != VK_SUCCESS) {
+        throw std::runtime_error(
+                "vkGetMemoryHostPointerPropertiesEXT failed with error code " + std::to_string(int(result)) + ".");
+    }
+
+    VkExternalMemoryBufferCreateInfo externalMemoryBufferCreateInfo{};
+    externalMemoryBufferCreateInfo.sType = VK_STRUCTURE_TYPE_EXTERNAL_MEMORY_BUFFER_CREATE_INFO;
+    externalMemoryBufferCreateInfo.handleTypes = VK_EXTERNAL_MEMORY_HANDLE_TYPE_HOST_ALLOCATION_BIT_EXT;
+    VkBufferCreateInfo bufferCreateInfo{};
+    bufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferCreateInfo.pNext = &externalMemoryBufferCreateInfo;
+    bufferCreateInfo.size = sizeInBytes;
+    bufferCreateInfo.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+    bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    result = vkCreateBuffer(vkDevice, &bufferCreateInfo, nullptr, &buffer);
+    if (result != VK_SUCCESS) {
+        throw std::runtime_error("vkCreateBuffer failed with error code " + std::to_string(int(result)) + ".");
+    }
+
+    VkMemoryRequirements memoryRequirements{};
+    vkGetBufferMemoryRequirements(vkDevice, buffer, &memoryRequirements);
+    uint32_t memoryTypeBits = memoryRequirements.memoryTypeBits & hostPointerProperties.memoryTypeBits;
+    const VkPhysicalDeviceMemoryProperties& deviceMemoryProperties = device->getMemoryProperties();
+    uint32_t memoryTypeIndex = deviceMemoryProperties.memoryTypeCount;
+    for (uint32_t i = 0; i < deviceMemoryProperties.memoryTypeCount; i++) {
+        if ((memoryTypeBits & (1u << i)) != 0) {
+            memoryTypeIndex = i;
+            break;
+        }
+    }
+    if (memoryTypeIndex == deviceMemoryProperties.memoryTypeCount) {
+        vkDestroyBuffer(vkDevice, buffer, nullptr);
+        throw std::runtime_error("No memory type is compatible with the imported host pointer.");
+    }
+
+    VkImportMemoryHostPointerInfoEXT importMemoryHostPointerInfo{};
+    importMemoryHostPointerInfo.sType = VK_STRUCTURE_TYPE_IMPORT_MEMORY_HOST_POINTER_INFO_EXT;
+    importMemoryHostPointerInfo.handleType = VK_EXTERNAL_MEMORY_HANDLE_TYPE_HOST_ALLOCATION_BIT_EXT;
+    importMemoryHostPointerInfo.pHostPointer = hostPtr;
+    VkMemoryAllocateFlagsInfo memoryAllocateFlagsInfo{};
+    memoryAllocateFlagsInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO;
+    memoryAllocateFlagsInfo.pNext = &importMemoryHostPointerInfo;
+    memoryAllocateFlagsInfo.flags = VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT;
+    VkMemoryAllocateInfo memoryAllocateInfo{};
+    memoryAllocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    memoryAllocateInfo.pNext = &memoryAllocateFlagsInfo;
+    memoryAllocateInfo.allocationSize = sizeInBytes;
+    memoryAllocateInfo.memoryTypeIndex = memoryTypeIndex;
+    result = vkAllocateMemory(vkDevice, &memoryAllocateInfo, nullptr, &deviceMemory);
+    if (result != VK_SUCCESS) {
+        vkDestroyBuffer(vkDevice, buffer, nullptr);
+        throw std::runtime_error("vkAllocateMemory failed with error code " + std::to_string(int(result)) + ".");
+    }
+    vkBindBufferMemory(vkDevice, buffer, deviceMemory, 0);
+
+    VkBufferDeviceAddressInfo bufferDeviceAddressInfo{};
+    bufferDeviceAddressInfo.sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO;
+    bufferDeviceAddressInfo.buffer = buffer;
+    deviceAddress = vkGetBufferDeviceAddress(vkDevice, &bufferDeviceAddressInfo);
+}
+
+HostImportedBuffer::~HostImportedBuffer() {
+    vkDestroyBuffer(device->getVkDevice(), buffer, nullptr);
+    vkFreeMemory(device->getVkDevice(), deviceMemory, nullptr);
+}
@@ -0,0 +1,106 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef BUFFERTEST64_HOSTMEMORY_HPP
+#define BUFFERTEST64_HOSTMEMORY_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include <Graphics/Vulkan/Utils/Device.hpp>
+
+/// Backing of host memory that is imported with VK_EXT_external_memory_host.
+enum class HostPageType {
+    // Regular pages from the C runtime heap.
+    REGULAR,
+    // Anonymous memory advised to use 2MiB transparent huge pages (Linux only).
+    TRANSPARENT_HUGE_PAGES,
+    // Shared mapping of a memfd with regular pages (Linux only).
+    MEMFD,
+    // Shared mapping of a memfd backed by hugetlbfs (Linux only; needs reserved huge pages).
+    MEMFD_HUGETLB
+};
+const int NUM_HOST_PAGE_TYPES = int(HostPageType::MEMFD_HUGETLB) + 1;
+inline const char* const HOST_PAGE_TYPE_NAMES[] = {
+    "regular pages",
+    "transparent huge pages",
+    "memfd",
+    "memfd (hugetlbfs)",
+};
+
+/**
+ * Host memory of a certain page type. The returned pointer is offset from a 2MiB aligned base address by
+ * pointerAlignment bytes, so it is aligned to exactly pointerAlignment (or to 2MiB if pointerAlignment is 0).
+ * This allows testing import alignments below and above VkPhysicalDeviceExternalMemoryHostPropertiesEXT::
+ * minImportedHostPointerAlignment independently of the page type.
+ */
+class HostMemory {
+public:
+    HostMemory(HostPageType pageType, size_t sizeInBytes, size_t pointerAlignment);
+    ~HostMemory();
+    HostMemory(const HostMemory&) = delete;
+    HostMemory& operator=(const HostMemory&) = delete;
+
+    /// Whether the page type is supported on this platform and the allocation succeeded.
+    [[nodiscard]] inline bool getIsValid() const { return data != nullptr; }
+    [[nodiscard]] inline void* getData() { return data; }
+    [[nodiscard]] inline size_t getSizeInBytes() const { return sizeInBytes; }
+
+private:
+    HostPageType pageType;
+    size_t sizeInBytes;
+    size_t mappingSizeInBytes = 0;
+    void* base = nullptr;
+    void* data = nullptr;
+    int fd = -1;
+};
+
+/**
+ * A storage buffer imported from existing host memory with VK_EXT_external_memory_host. Unlike
+ * sgl::vk::Buffer::allocateFromNewHostPointer, the memory is not allocated by the buffer, so the page type and
+ * alignment of the host memory can be chosen by the caller. The buffer is only accessible via its device address.
+ */
+class HostImportedBuffer {
+public:
+    /// Throws a std::runtime_error if the import fails, e.g., due to insufficient alignment of hostPtr.
+    HostImportedBuffer(sgl::vk::Device* device, void* hostPtr, size_t sizeInBytes);
+    ~HostImportedBuffer();
+    HostImportedBuffer(const HostImportedBuffer&) = delete;
+    HostImportedBuffer& operator=(const HostImportedBuffer&) = delete;
+
+    [[nodiscard]] inline VkBuffer getVkBuffer() { return buffer; }
+    [[nodiscard]] inline VkDeviceAddress getVkDeviceAddress() const { return deviceAddress; }
+
+private:
+    sgl::vk::Device* device;
+    VkBuffer buffer = VK_NULL_HANDLE;
+    VkDeviceMemory deviceMemory = VK_NULL_HANDLE;
+    VkDeviceAddress deviceAddress = 0;
+};
+
+#endif //BUFFERTEST64_HOSTMEMORY_HPP
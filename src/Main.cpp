@@ -26,6 +26,9 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <algorithm>
+#include <memory>
+
 #include <Math/Math.hpp>
 #include <Utils/AppSettings.hpp>
 #include <Utils/AppLogic.hpp>
@@ -37,12 +40,66 @@
 #include <Graphics/Vulkan/Utils/Swapchain.hpp>
 #include <Graphics/Vulkan/Shader/ShaderManager.hpp>
 
+#include "ResultsWriter.hpp"
+#include "CpuReference.hpp"
 #include "Tests.hpp"
 
 void vulkanErrorCallbackHeadless() {
     std::cerr << "Application callback" << std::endl;
 }
 
+static void printUsage() {
+    std::cout
+            << "Usage: BufferTest64 [options]" << std::endl
+            << std::endl
+            << "Test plan:" << std::endl
+            << "  --benchmark                     Stream every entry and report the read bandwidth." << std::endl
+            << "  --plan <file>                   Load the test plan from a JSON file." << std::endl
+            << "  --devices <list>                Indices of the tested devices, e.g., 0,1." << std::endl
+            << "  --modes <list>                  Test modes, e.g., storage-buffer,buffer-reference-64." << std::endl
+            << "  --types <list>                  Data types, e.g., float,uint8." << std::endl
+            << "  --sizes <list>                  Allocation sizes in float entries, e.g., 512x512x512x5." << std::endl
+            << "  --allocation device|host|both   Allocation kinds." << std::endl
+            << "  --repetitions <n>               Runs of each test case." << std::endl
+            << "  --workgroup-size <n>            Work group size of the benchmark kernels." << std::endl
+            << "  --iterations <n>                Timed iterations of the benchmarks." << std::endl
+            << std::endl
+            << "Modes replacing the fixed-size tests (at most one):" << std::endl
+            << "  --sweep                         Search the largest correctly readable buffer size." << std::endl
+            << "  --host-import-benchmark         Compare imported host memory with uploads." << std::endl
+            << "  --arena-benchmark               Compare the buffer arena with dedicated allocations." << std::endl
+            << "  --gather-benchmark              Read at generated indices." << std::endl
+            << "  --write-benchmark               Measure stores and atomics." << std::endl
+            << "  --download-benchmark            Stream a buffer back to the host." << std::endl
+            << "  --sparse-benchmark              Compare sparse-bound and dedicated buffers." << std::endl
+            << "  --pipelined-upload              Overlap uploads with compute." << std::endl
+            << "  --volume <file>                 Test a raw volume file." << std::endl
+            << std::endl
+            << "Mode options:" << std::endl
+            << "  --sweep-max-size <GiB>          Largest allocation attempted by the sweep." << std::endl
+            << "  --host-import-size <MiB>        Buffer size of the host import benchmark." << std::endl
+            << "  --arena-members <n>             Members of the arena benchmark." << std::endl
+            << "  --pipelined-cases <n>           Cases of the pipelined upload." << std::endl
+            << "  --pipelined-case-size <MiB>     Size of each pipelined case." << std::endl
+            << "  --volume-size <xs> <ys> <zs> <cs>  Dimensions of the volume file." << std::endl
+            << "  --volume-uint8                  The volume file holds uint8_t entries." << std::endl
+            << "  --volume-import                 Import the volume file mapping as host memory." << std::endl
+            << std::endl
+            << "Other options:" << std::endl
+            << "  --streaming-chunk-size <MiB>    Size of the staging chunks." << std::endl
+            << "  --streaming-chunks <n>          Number of staging chunks." << std::endl
+            << "  --host-fill                     Fill the buffers on the host instead of the GPU." << std::endl
+            << "  --no-buffer-pool                Allocate and fill the buffers for every test case." << std::endl
+            << "  --no-shader-disk-cache          Compile all shaders." << std::endl
+            << "  --sparse                        Use sparse-bound fields buffers." << std::endl
+            << "  --sparse-block-size <MiB>       Block size of the sparse buffers." << std::endl
+            << "  --arena                         Sub-allocate the storage buffer array members." << std::endl
+            << "  --results <file>                Write the results as JSON lines or CSV." << std::endl
+            << "  --cpu-devices                   Also test CPU Vulkan implementations." << std::endl
+            << "  --no-cpu-reference              Disable the CPU reference engine." << std::endl
+            << "  --help                          Print this message." << std::endl;
+}
+
 int main(int argc, char *argv[]) {
     // Initialize the filesystem utilities.
     sgl::FileUtils::get()->initialize("BufferTest64", argc, argv);
@@ -78,6 +135,12 @@ int main(int argc, char *argv[]) {
     requestedDeviceFeatures.requestedVulkan12Features.shaderStorageBufferArrayNonUniformIndexing = VK_TRUE;
     requestedDeviceFeatures.requestedVulkan12Features.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
     requestedDeviceFeatures.optionalVulkan12Features.storageBuffer8BitAccess = VK_TRUE;
+    requestedDeviceFeatures.optionalVulkan11Features.storageBuffer16BitAccess = VK_TRUE;
+    requestedDeviceFeatures.optionalVulkan12Features.shaderFloat16 = VK_TRUE;
+    requestedDeviceFeatures.optionalVulkan12Features.shaderBufferInt64Atomics = VK_TRUE;
+    requestedDeviceFeatures.optionalPhysicalDeviceFeatures.shaderInt16 = VK_TRUE;
+    requestedDeviceFeatures.optionalPhysicalDeviceFeatures.pipelineStatisticsQuery = VK_TRUE;
+    requestedDeviceFeatures.optionalPhysicalDeviceFeatures.sparseBinding = VK_TRUE;
     std::vector<const char*> requiredDeviceExtensions = {
             VK_EXT_SCALAR_BLOCK_LAYOUT_EXTENSION_NAME, VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME,
             VK_KHR_BUFFER_DEVICE_ADDRESS_EXTENSION_NAME,
@@ -85,6 +148,9 @@ int main(int argc, char *argv[]) {
     std::vector<const char*> optionalDeviceExtensions = {
             VK_KHR_SHADER_FLOAT16_INT8_EXTENSION_NAME,
             VK_KHR_8BIT_STORAGE_EXTENSION_NAME,
+            VK_KHR_16BIT_STORAGE_EXTENSION_NAME,
+            // https://docs.vulkan.org/refpages/latest/refpages/source/VK_EXT_memory_budget.html
+            VK_EXT_MEMORY_BUDGET_EXTENSION_NAME,
             VK_KHR_EXTERNAL_MEMORY_EXTENSION_NAME,
             // https://docs.vulkan.org/refpages/latest/refpages/source/VK_EXT_external_memory_host.html
             VK_EXT_EXTERNAL_MEMORY_HOST_EXTENSION_NAME,
@@ -92,36 +158,233 @@ int main(int argc, char *argv[]) {
             VK_EXT_SHADER_64BIT_INDEXING_EXTENSION_NAME
     };
 
+    TestSettings testSettings{};
+    std::string resultsFilePath;
+    auto exitWithUsageError = [](const std::string& message) {
+        std::cerr << "Usage error: " << message << std::endl;
+        sgl::AppSettings::get()->release();
+        return 1;
+    };
+    // The value parsers throw on invalid numbers and unknown names.
+    try {
+        for (int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            if (arg == "--help" || arg == "-h") {
+                printUsage();
+                sgl::AppSettings::get()->release();
+                return 0;
+            } else if (arg == "--benchmark") {
+                testSettings.benchmarkMode = true;
+            } else if (arg == "--plan" && i + 1 < argc) {
+                loadTestPlanFile(argv[++i], testSettings.testPlan, testSettings.benchmarkMode);
+            } else if (arg == "--devices" && i + 1 < argc) {
+                testSettings.testPlan.deviceIndices = parseDeviceIndexList(argv[++i]);
+            } else if (arg == "--modes" && i + 1 < argc) {
+                testSettings.testPlan.testModes = parseTestModeList(argv[++i]);
+            } else if (arg == "--types" && i + 1 < argc) {
+                testSettings.testPlan.dataTypes = parseDataTypeList(argv[++i]);
+            } else if (arg == "--sizes" && i + 1 < argc) {
+                testSettings.testPlan.allocationSizes = parseAllocationSizeList(argv[++i]);
+            } else if (arg == "--allocation" && i + 1 < argc) {
+                parseAllocationKind(argv[++i], testSettings.testPlan);
+            } else if (arg == "--repetitions" && i + 1 < argc) {
+                testSettings.testPlan.numRepetitions = parseRepetitions(argv[++i]);
+            } else if (arg == "--workgroup-size" && i + 1 < argc) {
+                testSettings.benchmarkWorkgroupSize = parseUint32(argv[++i]);
+            } else if (arg == "--iterations" && i + 1 < argc) {
+                testSettings.benchmarkNumIterations = parseUint32(argv[++i]);
+            } else if (arg == "--sweep") {
+                testSettings.sweepMode = true;
+            } else if (arg == "--sweep-max-size" && i + 1 < argc) {
+                testSettings.sweepMaxSizeInBytes = size_t(parseUint32(argv[++i])) * size_t(1024 * 1024 * 1024);
+            } else if (arg == "--host-import-benchmark") {
+                testSettings.hostImportBenchmarkMode = true;
+            } else if (arg == "--host-import-size" && i + 1 < argc) {
+                testSettings.hostImportSizeInBytes = size_t(parseUint32(argv[++i])) * size_t(1024 * 1024);
+            } else if (arg == "--pipelined-upload") {
+                testSettings.pipelinedUploadMode = true;
+            } else if (arg == "--pipelined-cases" && i + 1 < argc) {
+                testSettings.pipelinedNumCases = parseUint32(argv[++i]);
+            } else if (arg == "--pipelined-case-size" && i + 1 < argc) {
+                testSettings.pipelinedCaseSizeInBytes = size_t(parseUint32(argv[++i])) * size_t(1024 * 1024);
+            } else if (arg == "--streaming-chunk-size" && i + 1 < argc) {
+                testSettings.streamingChunkSizeInBytes = size_t(parseUint32(argv[++i])) * size_t(1024 * 1024);
+            } else if (arg == "--streaming-chunks" && i + 1 < argc) {
+                testSettings.numStreamingChunks = parseUint32(argv[++i]);
+            } else if (arg == "--host-fill") {
+                testSettings.useGpuGeneration = false;
+            } else if (arg == "--no-buffer-pool") {
+                testSettings.useBufferPool = false;
+            } else if (arg == "--no-shader-disk-cache") {
+                testSettings.useShaderDiskCache = false;
+            } else if (arg == "--gather-benchmark") {
+                testSettings.gatherBenchmarkMode = true;
+            } else if (arg == "--write-benchmark") {
+                testSettings.writeBenchmarkMode = true;
+            } else if (arg == "--download-benchmark") {
+                testSettings.downloadBenchmarkMode = true;
+            } else if (arg == "--sparse") {
+                testSettings.useSparseBinding = true;
+            } else if (arg == "--sparse-block-size" && i + 1 < argc) {
+                testSettings.sparseBlockSizeInBytes = size_t(parseUint32(argv[++i])) * size_t(1024 * 1024);
+            } else if (arg == "--sparse-benchmark") {
+                testSettings.sparseBenchmarkMode = true;
+            } else if (arg == "--arena") {
+                testSettings.useBufferArena = true;
+            } else if (arg == "--arena-benchmark") {
+                testSettings.arenaBenchmarkMode = true;
+            } else if (arg == "--arena-members" && i + 1 < argc) {
+                testSettings.arenaNumMembers = parseUint32(argv[++i]);
+            } else if (arg == "--volume" && i + 1 < argc) {
+                testSettings.volumeFilePath = argv[++i];
+            } else if (arg == "--volume-size" && i + 4 < argc) {
+                testSettings.volumeXs = parseUint32(argv[++i]);
+                testSettings.volumeYs = parseUint32(argv[++i]);
+                testSettings.volumeZs = parseUint32(argv[++i]);
+                testSettings.volumeCs = parseUint32(argv[++i]);
+            } else if (arg == "--volume-uint8") {
+                testSettings.volumeDataType = TestDataType::UINT8;
+            } else if (arg == "--volume-import") {
+                testSettings.volumeImportMapping = true;
+            } else if (arg == "--results" && i + 1 < argc) {
+                resultsFilePath = argv[++i];
+            } else if (arg == "--cpu-devices") {
+                testSettings.allowCpuDevices = true;
+            } else if (arg == "--no-cpu-reference") {
+                testSettings.useCpuReference = false;
+            } else {
+                return exitWithUsageError("Unknown or incomplete argument: " + arg);
+            }
+        }
+    } catch (const std::exception& e) {
+        return exitWithUsageError(e.what());
+    }
+    // The modes replacing the fixed-size tests are mutually exclusive.
+    const std::pair<bool, const char*> exclusiveModes[] = {
+            { testSettings.sweepMode, "--sweep" },
+            { testSettings.hostImportBenchmarkMode, "--host-import-benchmark" },
+            { testSettings.arenaBenchmarkMode, "--arena-benchmark" },
+            { testSettings.gatherBenchmarkMode, "--gather-benchmark" },
+            { testSettings.writeBenchmarkMode, "--write-benchmark" },
+            { testSettings.downloadBenchmarkMode, "--download-benchmark" },
+            { testSettings.sparseBenchmarkMode, "--sparse-benchmark" },
+            { testSettings.pipelinedUploadMode, "--pipelined-upload" },
+            { !testSettings.volumeFilePath.empty(), "--volume" },
+    };
+    std::string selectedModes;
+    int numSelectedModes = 0;
+    for (const auto& exclusiveMode : exclusiveModes) {
+        if (exclusiveMode.first) {
+            selectedModes += numSelectedModes == 0 ? "" : ", ";
+            selectedModes += exclusiveMode.second;
+            numSelectedModes++;
+        }
+    }
+    if (numSelectedModes > 1) {
+        return exitWithUsageError("Only one of the modes " + selectedModes + " can be selected.");
+    }
+    if (testSettings.streamingChunkSizeInBytes == 0) {
+        return exitWithUsageError("--streaming-chunk-size needs to be at least 1 (MiB).");
+    }
+    if (testSettings.numStreamingChunks == 0) {
+        return exitWithUsageError("--streaming-chunks needs to be at least 1.");
+    }
+    if (testSettings.benchmarkWorkgroupSize == 0) {
+        return exitWithUsageError("--workgroup-size needs to be at least 1.");
+    }
+    if (testSettings.benchmarkNumIterations == 0) {
+        return exitWithUsageError("--iterations needs to be at least 1.");
+    }
+    std::unique_ptr<ResultsWriter> resultsWriter;
+    if (!resultsFilePath.empty()) {
+        resultsWriter = std::make_unique<ResultsWriter>(resultsFilePath);
+        if (!testSettings.sweepMode && !getRunsFixedSizeTests(testSettings)) {
+            std::cout << "Warning: --results only covers the fixed-size tests and the sweep; no records are written "
+                    << "in this mode." << std::endl;
+        }
+    }
+
     std::vector<VkPhysicalDevice> physicalDevices = sgl::vk::enumeratePhysicalDevices(instance);
     std::vector<VkPhysicalDevice> suitablePhysicalDevices;
     VkPhysicalDeviceProperties physicalDeviceProperties{};
+    size_t suitableDeviceIdx = 0;
     for (auto& physicalDevice : physicalDevices) {
         sgl::vk::getPhysicalDeviceProperties(physicalDevice, physicalDeviceProperties);
-        if (physicalDeviceProperties.deviceType == VK_PHYSICAL_DEVICE_TYPE_CPU) {
+        if (physicalDeviceProperties.deviceType == VK_PHYSICAL_DEVICE_TYPE_CPU && !testSettings.allowCpuDevices) {
             continue;
         }
         if (sgl::vk::checkIsPhysicalDeviceSuitable(
                 instance, physicalDevice, nullptr, requiredDeviceExtensions, requestedDeviceFeatures, true)) {
-            suitablePhysicalDevices.push_back(physicalDevice);
+            // Devices not selected by the test plan are not created at all.
+            if (testSettings.testPlan.getIsDeviceSelected(suitableDeviceIdx)) {
+                suitablePhysicalDevices.push_back(physicalDevice);
+            }
+            suitableDeviceIdx++;
         }
     }
-    for (size_t i = 0; i < suitablePhysicalDevices.size(); i++) {
-        if (i != 0) {
-            std::cout << std::endl << "--------------------------------------------" << std::endl << std::endl;
+    if (suitablePhysicalDevices.empty()) {
+        sgl::AppSettings::get()->release();
+        return 0;
+    }
+    for (auto physicalDevice : suitablePhysicalDevices) {
+        sgl::vk::getPhysicalDeviceProperties(physicalDevice, physicalDeviceProperties);
+        const VkPhysicalDeviceLimits& limits = physicalDeviceProperties.limits;
+        uint32_t maxWorkgroupSize = std::min(limits.maxComputeWorkGroupSize[0], limits.maxComputeWorkGroupInvocations);
+        if (testSettings.benchmarkWorkgroupSize > maxWorkgroupSize) {
+            return exitWithUsageError(
+                    "--workgroup-size " + std::to_string(testSettings.benchmarkWorkgroupSize) + " exceeds the limit of "
+                    + std::to_string(maxWorkgroupSize) + " of " + physicalDeviceProperties.deviceName + ".");
         }
-        auto physicalDevice = suitablePhysicalDevices.at(i);
+    }
+
+    // The first device is the primary device used by the global sgl subsystems (e.g., the shader manager).
+    std::vector<sgl::vk::Device*> devices;
+    for (auto physicalDevice : suitablePhysicalDevices) {
         auto* device = new sgl::vk::Device;
         device->createDeviceHeadlessFromPhysicalDevice(
                 instance, physicalDevice, requiredDeviceExtensions,
                 optionalDeviceExtensions, requestedDeviceFeatures, false);
+        devices.push_back(device);
+    }
+    sgl::AppSettings::get()->setPrimaryDevice(devices.front());
+    sgl::AppSettings::get()->initializeSubsystems();
 
-        sgl::AppSettings::get()->setPrimaryDevice(device);
-        sgl::AppSettings::get()->initializeSubsystems();
+    // The devices are tested one after another, as the sgl subsystems (e.g., the log file and the application
+    // settings) are global singletons that are not synchronized across threads. Each device has its own ShaderCache.
+    // The CPU reference cross-checks the float results of all devices.
+    GpuTestResults gpuTestResults;
+    for (size_t i = 0; i < devices.size(); i++) {
+        if (i != 0) {
+            std::cout << std::endl << "--------------------------------------------" << std::endl << std::endl;
+        }
+        try {
+            runTests(
+                    testSettings, devices.at(i), std::cout, resultsWriter.get(),
+                    testSettings.useCpuReference ? &gpuTestResults : nullptr);
+        } catch (const std::exception& e) {
+            std::cout << "Error: " << e.what() << std::endl;
+        }
+    }
 
-        runTests();
+    // Runs after all devices, so it does not compete with the device tests for the host cores and memory.
+    if (testSettings.useCpuReference && getRunsFixedSizeTests(testSettings)
+            && testSettings.testPlan.getIsDataTypeSelected(TestDataType::FLOAT)) {
+        bool isCpuDeviceOnly = true;
+        for (sgl::vk::Device* device : devices) {
+            if (device->getPhysicalDeviceProperties().deviceType != VK_PHYSICAL_DEVICE_TYPE_CPU) {
+                isCpuDeviceOnly = false;
+            }
+        }
+        std::cout << std::endl << "--------------------------------------------" << std::endl;
+        for (const auto& allocSize : getAllocationSizes(testSettings.testPlan, isCpuDeviceOnly)) {
+            runCpuReference(testSettings, std::cout, allocSize, &gpuTestResults);
+        }
+    }
 
-        sgl::AppSettings::get()->releaseDeviceHeadless();
+    for (size_t i = 1; i < devices.size(); i++) {
+        delete devices.at(i);
     }
+    sgl::AppSettings::get()->releaseDeviceHeadless();
     sgl::AppSettings::get()->release();
 
     return 0;
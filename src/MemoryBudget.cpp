@@ -0,0 +1,152 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#endif
+
+#include <Graphics/Vulkan/Utils/Device.hpp>
+#include <ImGui/Widgets/NumberFormatting.hpp>
+
+#include "MemoryBudget.hpp"
+
+// Memory left free for other processes, the driver and small allocations like staging and output buffers.
+static const size_t SAFETY_MARGIN_BYTES = size_t(512) * size_t(1024) * size_t(1024);
+
+MemoryBudget::MemoryBudget(sgl::vk::Device* device) : device(device) {
+    isBudgetExtensionSupported = device->isDeviceExtensionEnabled(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+}
+
+bool MemoryBudget::queryDeviceLocalHeaps(size_t& usageInBytes, size_t& budgetInBytes, size_t& availableInBytes) {
+    VkPhysicalDeviceMemoryBudgetPropertiesEXT memoryBudgetProperties{};
+    memoryBudgetProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+    VkPhysicalDeviceMemoryProperties2 memoryProperties2{};
+    memoryProperties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
+    if (isBudgetExtensionSupported) {
+        memoryProperties2.pNext = &memoryBudgetProperties;
+    }
+    vkGetPhysicalDeviceMemoryProperties2(device->getVkPhysicalDevice(), &memoryProperties2);
+    const VkPhysicalDeviceMemoryProperties& memoryProperties = memoryProperties2.memoryProperties;
+
+    bool isWithinBudget = true;
+    usageInBytes = 0;
+    budgetInBytes = 0;
+    availableInBytes = 0;
+    for (uint32_t heapIdx = 0; heapIdx < memoryProperties.memoryHeapCount; heapIdx++) {
+        if ((memoryProperties.memoryHeaps[heapIdx].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) == 0) {
+            continue;
+        }
+        size_t heapUsage = 0;
+        size_t heapBudget = size_t(memoryProperties.memoryHeaps[heapIdx].size);
+        if (isBudgetExtensionSupported) {
+            heapUsage = size_t(memoryBudgetProperties.heapUsage[heapIdx]);
+            heapBudget = size_t(memoryBudgetProperties.heapBudget[heapIdx]);
+        }
+        if (heapUsage > heapBudget) {
+            isWithinBudget = false;
+        }
+        usageInBytes += heapUsage;
+        // The test buffers are allocated from a single heap, so only the largest free heap counts.
+        size_t heapAvailable = heapBudget > heapUsage ? heapBudget - heapUsage : 0;
+        if (heapAvailable >= availableInBytes) {
+            availableInBytes = heapAvailable;
+            budgetInBytes = heapBudget;
+        }
+    }
+    return isWithinBudget;
+}
+
+size_t MemoryBudget::getDeviceAvailableBytes() {
+    size_t usageInBytes = 0, budgetInBytes = 0, availableInBytes = 0;
+    queryDeviceLocalHeaps(usageInBytes, budgetInBytes, availableInBytes);
+    return availableInBytes;
+}
+
+size_t MemoryBudget::getHostAvailableBytes() {
+#if defined(__linux__)
+    // MemAvailable also counts the page cache that can be reclaimed without swapping.
+    std::ifstream meminfoFile("/proc/meminfo");
+    std::string line;
+    while (std::getline(meminfoFile, line)) {
+        if (line.rfind("MemAvailable:", 0) == 0) {
+            std::istringstream lineStream(line.substr(13));
+            size_t availableKiB = 0;
+            if (lineStream >> availableKiB) {
+                return availableKiB * size_t(1024);
+            }
+        }
+    }
+#elif defined(_WIN32)
+    MEMORYSTATUSEX memoryStatus{};
+    memoryStatus.dwLength = sizeof(memoryStatus);
+    if (GlobalMemoryStatusEx(&memoryStatus)) {
+        return size_t(memoryStatus.ullAvailPhys);
+    }
+#endif
+    return SIZE_MAX;
+}
+
+bool MemoryBudget::getFits(const MemoryRequirement& requirement) {
+    size_t deviceAvailableBytes = getDeviceAvailableBytes();
+    if (requirement.deviceSizeInBytes + SAFETY_MARGIN_BYTES > deviceAvailableBytes) {
+        return false;
+    }
+    size_t hostAvailableBytes = getHostAvailableBytes();
+    if (hostAvailableBytes != SIZE_MAX && requirement.hostSizeInBytes + SAFETY_MARGIN_BYTES > hostAvailableBytes) {
+        return false;
+    }
+    return true;
+}
+
+void MemoryBudget::beginCase() {
+    size_t availableInBytes = 0;
+    caseIsResident = queryDeviceLocalHeaps(caseStartUsageInBytes, caseBudgetInBytes, availableInBytes);
+    casePeakUsageInBytes = caseStartUsageInBytes;
+}
+
+void MemoryBudget::sample() {
+    size_t usageInBytes = 0, budgetInBytes = 0, availableInBytes = 0;
+    bool isWithinBudget = queryDeviceLocalHeaps(usageInBytes, budgetInBytes, availableInBytes);
+    caseIsResident = caseIsResident && isWithinBudget;
+    casePeakUsageInBytes = std::max(casePeakUsageInBytes, usageInBytes);
+}
+
+void MemoryBudget::printCaseSummary(std::ostream& out) const {
+    if (!isBudgetExtensionSupported) {
+        return;
+    }
+    size_t caseUsageInBytes = casePeakUsageInBytes - std::min(casePeakUsageInBytes, caseStartUsageInBytes);
+    out
+            << "Device-local memory: peak usage " << sgl::getNiceMemoryString(casePeakUsageInBytes, 2)
+            << " (+" << sgl::getNiceMemoryString(caseUsageInBytes, 2) << " by this case) of " << sgl::getNiceMemoryString(caseBudgetInBytes, 2) << " budget, "
+            << (caseIsResident ? "resident" : "oversubscribed, the times may include paging") << std::endl;
+}
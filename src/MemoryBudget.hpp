@@ -0,0 +1,82 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef BUFFERTEST64_MEMORYBUDGET_HPP
+#define BUFFERTEST64_MEMORYBUDGET_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace sgl { namespace vk {
+class Device;
+}}
+
+/// Memory needed by one test case, estimated before any of its buffers is allocated.
+struct MemoryRequirement {
+    size_t deviceSizeInBytes = 0;
+    size_t hostSizeInBytes = 0;
+};
+
+/**
+ * Tracks the free device-local and host memory with VK_EXT_memory_budget and the free physical host memory, so test
+ * cases that would oversubscribe memory can be deferred or skipped instead of being measured while paging. Without
+ * VK_EXT_memory_budget, the full size of the largest device-local heap is assumed to be available.
+ */
+class MemoryBudget {
+public:
+    explicit MemoryBudget(sgl::vk::Device* device);
+
+    [[nodiscard]] inline bool getIsBudgetExtensionSupported() const { return isBudgetExtensionSupported; }
+    /// Free memory of the device-local heap with the largest budget.
+    [[nodiscard]] size_t getDeviceAvailableBytes();
+    /// Free physical host memory, or SIZE_MAX if it can't be queried on this platform.
+    [[nodiscard]] static size_t getHostAvailableBytes();
+    /// Whether the requirement fits into the free memory, leaving a safety margin for other processes and the driver.
+    bool getFits(const MemoryRequirement& requirement);
+
+    /// Starts tracking the peak device-local usage of a test case.
+    void beginCase();
+    /// Updates the peak usage and checks whether all device-local heaps are still within their budget.
+    void sample();
+    /// Prints the peak usage and residency of the current test case.
+    void printCaseSummary(std::ostream& out) const;
+
+private:
+    /// Queries the usage and budget of the device-local heaps. Returns false if the usage exceeds the budget.
+    bool queryDeviceLocalHeaps(size_t& usageInBytes, size_t& budgetInBytes, size_t& availableInBytes);
+
+    sgl::vk::Device* device;
+    bool isBudgetExtensionSupported = false;
+    size_t caseStartUsageInBytes = 0;
+    size_t casePeakUsageInBytes = 0;
+    size_t caseBudgetInBytes = 0;
+    bool caseIsResident = true;
+};
+
+#endif //BUFFERTEST64_MEMORYBUDGET_HPP
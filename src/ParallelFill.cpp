@@ -0,0 +1,187 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <climits>
+
+#if defined(__linux__)
+#include <sys/resource.h>
+#endif
+
+#include <ImGui/Widgets/NumberFormatting.hpp>
+
+#include "ParallelFill.hpp"
+
+// Don't spawn threads for blocks smaller than this; the thread start-up cost would dominate.
+static const size_t MIN_BYTES_PER_THREAD = size_t(16) * size_t(1024) * size_t(1024);
+static const size_t PAGE_SIZE_BYTES = 4096;
+
+/// Page faults of the calling thread only; the process-wide count includes fills running concurrently on other threads.
+static int64_t getNumPageFaults() {
+#if defined(__linux__)
+    struct rusage usage{};
+    if (getrusage(RUSAGE_THREAD, &usage) == 0) {
+        return int64_t(usage.ru_minflt) + int64_t(usage.ru_majflt);
+    }
+#endif
+    return -1;
+}
+
+double FillStatistics::getBandwidthGBs() const {
+    if (timeSeconds <= 0.0) {
+        return 0.0;
+    }
+    return double(sizeInBytes) / timeSeconds * 1e-9;
+}
+
+FillStatistics parallelFill(
+        size_t numEntries, size_t entrySize, const std::function<void(size_t begin, size_t end)>& fillRange) {
+    FillStatistics fillStatistics{};
+    fillStatistics.sizeInBytes = numEntries * entrySize;
+
+    size_t numThreads = std::max(size_t(std::thread::hardware_concurrency()), size_t(1));
+    numThreads = std::min(numThreads, std::max(fillStatistics.sizeInBytes / MIN_BYTES_PER_THREAD, size_t(1)));
+    size_t entriesPerPage = std::max(PAGE_SIZE_BYTES / entrySize, size_t(1));
+    size_t entriesPerThread = (numEntries + numThreads - 1) / numThreads;
+    entriesPerThread = (entriesPerThread + entriesPerPage - 1) / entriesPerPage * entriesPerPage;
+
+    // Each thread counts its own page faults, as the process-wide count includes page faults of unrelated threads.
+    std::atomic<int64_t> numPageFaults{0};
+    std::atomic<bool> hasPageFaults{true};
+    auto fillRangeCounted = [&](size_t begin, size_t end) {
+        int64_t numPageFaultsStart = getNumPageFaults();
+        fillRange(begin, end);
+        int64_t numPageFaultsEnd = getNumPageFaults();
+        if (numPageFaultsStart >= 0 && numPageFaultsEnd >= 0) {
+            numPageFaults += numPageFaultsEnd - numPageFaultsStart;
+        } else {
+            hasPageFaults = false;
+        }
+    };
+
+    auto startTime = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads);
+    for (size_t threadIdx = 0; threadIdx < numThreads; threadIdx++) {
+        size_t begin = threadIdx * entriesPerThread;
+        size_t end = std::min(begin + entriesPerThread, numEntries);
+        if (begin >= end) {
+            break;
+        }
+        if (threadIdx == numThreads - 1 || end == numEntries) {
+            // Let the calling thread do the last block instead of idling.
+            fillRangeCounted(begin, end);
+            break;
+        }
+        threads.emplace_back(fillRangeCounted, begin, end);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    auto endTime = std::chrono::steady_clock::now();
+
+    fillStatistics.timeSeconds = std::chrono::duration<double>(endTime - startTime).count();
+    if (hasPageFaults) {
+        fillStatistics.numPageFaults = numPageFaults;
+    }
+    return fillStatistics;
+}
+
+void writeIndexPattern(float* dst, size_t begin, size_t end, size_t numEntries, float lastValue) {
+    size_t endPattern = std::min(end, numEntries - 1);
+    if (endPattern <= size_t(INT32_MAX)) {
+        // int32_t -> float conversions can be vectorized on all x86-64 and ARMv8 targets, uint64_t -> float can't.
+        auto beginSigned = int32_t(begin);
+        auto endSigned = int32_t(endPattern);
+        for (int32_t j = beginSigned; j < endSigned; j++) {
+            dst[j - beginSigned] = float(j);
+        }
+    } else {
+        for (size_t j = begin; j < endPattern; j++) {
+            dst[j - begin] = float(j);
+        }
+    }
+    if (end == numEntries) {
+        dst[end - 1 - begin] = lastValue;
+    }
+}
+
+template<class T>
+static void writeConstantPatternT(T* dst, size_t begin, size_t end, size_t numEntries, T value, T lastValue) {
+    size_t endPattern = std::min(end, numEntries - 1);
+    for (size_t j = begin; j < endPattern; j++) {
+        dst[j - begin] = value;
+    }
+    if (end == numEntries) {
+        dst[end - 1 - begin] = lastValue;
+    }
+}
+
+void writeConstantPattern(float* dst, size_t begin, size_t end, size_t numEntries, float value, float lastValue) {
+    writeConstantPatternT(dst, begin, end, numEntries, value, lastValue);
+}
+
+void writeConstantPattern(
+        uint8_t* dst, size_t begin, size_t end, size_t numEntries, uint8_t value, uint8_t lastValue) {
+    writeConstantPatternT(dst, begin, end, numEntries, value, lastValue);
+}
+
+void writeConstantPattern(
+        uint16_t* dst, size_t begin, size_t end, size_t numEntries, uint16_t value, uint16_t lastValue) {
+    writeConstantPatternT(dst, begin, end, numEntries, value, lastValue);
+}
+
+void writeConstantPattern(
+        uint32_t* dst, size_t begin, size_t end, size_t numEntries, uint32_t value, uint32_t lastValue) {
+    writeConstantPatternT(dst, begin, end, numEntries, value, lastValue);
+}
+
+void writeConstantPattern(
+        uint64_t* dst, size_t begin, size_t end, size_t numEntries, uint64_t value, uint64_t lastValue) {
+    writeConstantPatternT(dst, begin, end, numEntries, value, lastValue);
+}
+
+FillStatistics fillConstantPattern(float* data, size_t numEntries, float value, float lastValue) {
+    return parallelFill(numEntries, sizeof(float), [=](size_t begin, size_t end) {
+        writeConstantPattern(data + begin, begin, end, numEntries, value, lastValue);
+    });
+}
+
+void printFillStatistics(std::ostream& out, const FillStatistics& fillStatistics) {
+    out
+            << "Host fill: " << sgl::getNiceMemoryString(fillStatistics.sizeInBytes, 2)
+            << " in " << (fillStatistics.timeSeconds * 1e3) << "ms (" << fillStatistics.getBandwidthGBs() << " GB/s";
+    if (fillStatistics.numPageFaults >= 0) {
+        out << ", " << fillStatistics.numPageFaults << " page faults";
+    }
+    out << ")" << std::endl;
+}
@@ -0,0 +1,73 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef BUFFERTEST64_PARALLELFILL_HPP
+#define BUFFERTEST64_PARALLELFILL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+
+struct FillStatistics {
+    size_t sizeInBytes = 0;
+    double timeSeconds = 0.0;
+    // Number of page faults triggered by the fill; -1 if not available on this platform.
+    int64_t numPageFaults = -1;
+    [[nodiscard]] double getBandwidthGBs() const;
+};
+
+/**
+ * Calls fillRange(begin, end) concurrently on all hardware threads. The range [0, numEntries) is split into one
+ * contiguous block per thread. Block boundaries are aligned to the page size, so each page is first touched (and thus
+ * faulted in) by exactly one thread.
+ */
+FillStatistics parallelFill(
+        size_t numEntries, size_t entrySize, const std::function<void(size_t begin, size_t end)>& fillRange);
+
+/**
+ * Write the entries [begin, end) of a pattern with numEntries entries to dst[0, end - begin). Single-threaded; meant to
+ * be called from the fillRange function passed to parallelFill. writeIndexPattern writes float(i) to entry i, and
+ * writeConstantPattern writes value. In both cases, the last entry of the pattern is set to lastValue.
+ */
+void writeIndexPattern(float* dst, size_t begin, size_t end, size_t numEntries, float lastValue);
+void writeConstantPattern(float* dst, size_t begin, size_t end, size_t numEntries, float value, float lastValue);
+void writeConstantPattern(uint8_t* dst, size_t begin, size_t end, size_t numEntries, uint8_t value, uint8_t lastValue);
+void writeConstantPattern(
+        uint16_t* dst, size_t begin, size_t end, size_t numEntries, uint16_t value, uint16_t lastValue);
+void writeConstantPattern(
+        uint32_t* dst, size_t begin, size_t end, size_t numEntries, uint32_t value, uint32_t lastValue);
+void writeConstantPattern(
+        uint64_t* dst, size_t begin, size_t end, size_t numEntries, uint64_t value, uint64_t lastValue);
+
+/// Writes value to all entries except the last one, which is set to lastValue.
+FillStatistics fillConstantPattern(float* data, size_t numEntries, float value, float lastValue);
+
+void printFillStatistics(std::ostream& out, const FillStatistics& fillStatistics);
+
+#endif //BUFFERTEST64_PARALLELFILL_HPP
@@ -0,0 +1,95 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <algorithm>
+#include <iomanip>
+
+#include "PhaseStatistics.hpp"
+
+PhaseStatistics::Case& PhaseStatistics::getCase(const std::string& caseName) {
+    // Linear search, as there are only a few cases per device and they are printed in insertion order.
+    for (Case& testCase : cases) {
+        if (testCase.name == caseName) {
+            return testCase;
+        }
+    }
+    cases.emplace_back();
+    cases.back().name = caseName;
+    return cases.back();
+}
+
+void PhaseStatistics::addSample(const std::string& caseName, TestPhase phase, double seconds) {
+    getCase(caseName).samples[int(phase)].push_back(seconds);
+}
+
+void PhaseStatistics::addComputeInvocations(const std::string& caseName, uint64_t numInvocations) {
+    getCase(caseName).computeInvocations.push_back(numInvocations);
+}
+
+void PhaseStatistics::clear() {
+    cases.clear();
+}
+
+static double getMedian(std::vector<double> samples) {
+    std::sort(samples.begin(), samples.end());
+    size_t mid = samples.size() / 2;
+    if (samples.size() % 2 == 0) {
+        return (samples[mid - 1] + samples[mid]) * 0.5;
+    }
+    return samples[mid];
+}
+
+void PhaseStatistics::printSummary(std::ostream& out) const {
+    if (cases.empty()) {
+        return;
+    }
+    out << std::endl << "Phase summary:" << std::endl;
+    out
+            << std::left << std::setw(64) << "Case" << std::setw(20) << "Phase" << std::right
+            << std::setw(6) << "N" << std::setw(14) << "Min [ms]" << std::setw(14) << "Median [ms]"
+            << std::setw(14) << "Max [ms]" << std::endl;
+    for (const Case& testCase : cases) {
+        for (int phaseIdx = 0; phaseIdx < NUM_TEST_PHASES; phaseIdx++) {
+            const std::vector<double>& samples = testCase.samples[phaseIdx];
+            if (samples.empty()) {
+                continue;
+            }
+            auto minMax = std::minmax_element(samples.begin(), samples.end());
+            out
+                    << std::left << std::setw(64) << testCase.name << std::setw(20) << TEST_PHASE_NAMES[phaseIdx]
+                    << std::right << std::setw(6) << samples.size()
+                    << std::setw(14) << (*minMax.first * 1e3) << std::setw(14) << (getMedian(samples) * 1e3)
+                    << std::setw(14) << (*minMax.second * 1e3) << std::endl;
+        }
+        if (!testCase.computeInvocations.empty()) {
+            auto minMax = std::minmax_element(testCase.computeInvocations.begin(), testCase.computeInvocations.end());
+            out << std::left << std::setw(64) << testCase.name << std::setw(20) << "invocations" << std::right
+                << std::setw(6) << testCase.computeInvocations.size() << std::setw(14) << *minMax.first
+                << std::setw(14) << "" << std::setw(14) << *minMax.second << std::endl;
+        }
+    }
+}
@@ -0,0 +1,67 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef BUFFERTEST64_PHASESTATISTICS_HPP
+#define BUFFERTEST64_PHASESTATISTICS_HPP
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+enum class TestPhase {
+    ALLOCATION, FILL, UPLOAD, SHADER_COMPILE, PIPELINE_CREATION, DISPATCH, READBACK, WAIT
+};
+const int NUM_TEST_PHASES = int(TestPhase::WAIT) + 1;
+const char* const TEST_PHASE_NAMES[] = {
+        "allocation", "fill", "upload", "shader compile", "pipeline creation", "dispatch", "readback", "wait"
+};
+
+/**
+ * Collects the CPU and GPU times of the phases of each test case over all repetitions and prints their minimum,
+ * median and maximum. A case is identified by a name like "5GiB, float, device, Storage buffer"; phases without
+ * samples, e.g., the allocation of a pooled buffer, are omitted from the summary.
+ */
+class PhaseStatistics {
+public:
+    void addSample(const std::string& caseName, TestPhase phase, double seconds);
+    /// Compute shader invocations of one dispatch, as reported by a pipeline statistics query.
+    void addComputeInvocations(const std::string& caseName, uint64_t numInvocations);
+    void clear();
+    void printSummary(std::ostream& out) const;
+
+private:
+    struct Case {
+        std::string name;
+        std::vector<double> samples[NUM_TEST_PHASES];
+        std::vector<uint64_t> computeInvocations;
+    };
+    Case& getCase(const std::string& caseName);
+    std::vector<Case> cases;
+};
+
+#endif //BUFFERTEST64_PHASESTATISTICS_HPP
@@ -0,0 +1,266 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+
+#include <Graphics/Vulkan/Utils/Device.hpp>
+#include <Graphics/Vulkan/Buffers/Buffer.hpp>
+#include <Graphics/Vulkan/Render/Renderer.hpp>
+#include <ImGui/Widgets/NumberFormatting.hpp>
+
+#include "Timing.hpp"
+#include "FieldsBuffers.hpp"
+#include "StreamingUpload.hpp"
+#include "GpuTimer.hpp"
+#include "ComputeQueueSubmitter.hpp"
+#include "BufferBenchmarkComputePass.hpp"
+#include "PipelinedUpload.hpp"
+
+static const uint32_t PIPELINE_XS = 512;
+static const uint32_t PIPELINE_YS = 512;
+static const uint32_t PIPELINE_ZS = 16;
+static const size_t PIPELINE_SLICE_ENTRIES = size_t(PIPELINE_XS) * size_t(PIPELINE_YS) * size_t(PIPELINE_ZS);
+
+struct PipelineTimings {
+    double wallSeconds = 0.0;
+    double uploadSeconds = 0.0;
+    // Uploads that can overlap with compute, i.e., all but the first one.
+    double overlappableUploadSeconds = 0.0;
+    double computeSeconds = 0.0;
+    uint32_t numMismatches = 0;
+};
+
+/**
+ * Returns a queue other than the compute queue the uploads can be submitted to. The sgl device only creates graphics
+ * and compute queues, so this is the graphics queue if the compute queue is a separate one, e.g., of a dedicated compute
+ * queue family. Dedicated transfer queue families of the physical device are only reported, as no queues exist for them.
+ * Returns false if there is no such queue.
+ */
+static bool findUploadQueue(
+        sgl::vk::Device* device, std::ostream& out, uint32_t& queueFamilyIndex, VkQueue& queue) {
+    uint32_t numQueueFamilies = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(device->getVkPhysicalDevice(), &numQueueFamilies, nullptr);
+    std::vector<VkQueueFamilyProperties> queueFamilyProperties(numQueueFamilies);
+    vkGetPhysicalDeviceQueueFamilyProperties(
+            device->getVkPhysicalDevice(), &numQueueFamilies, queueFamilyProperties.data());
+    for (uint32_t familyIdx = 0; familyIdx < numQueueFamilies; familyIdx++) {
+        VkQueueFlags queueFlags = queueFamilyProperties.at(familyIdx).queueFlags;
+        if ((queueFlags & VK_QUEUE_TRANSFER_BIT) != 0
+                && (queueFlags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT)) == 0) {
+            out << "Dedicated transfer queue family " << familyIdx << " exists, but has no queue on this device"
+                    << std::endl;
+        }
+    }
+
+    if (device->getGraphicsQueue() != VK_NULL_HANDLE && device->getGraphicsQueue() != device->getComputeQueue()) {
+        queueFamilyIndex = device->getGraphicsQueueIndex();
+        queue = device->getGraphicsQueue();
+        out << "Upload queue: graphics queue (family " << queueFamilyIndex << "), compute queue family "
+                << device->getComputeQueueIndex() << std::endl;
+        return true;
+    }
+    out << "No upload queue separate from the compute queue is available, skipping the pipelined run." << std::endl;
+    return false;
+}
+
+static void printRow(std::ostream& out, const std::string& name, const PipelineTimings& timings) {
+    out << std::left << std::setw(12) << name << std::right << std::fixed << std::setprecision(2);
+    out << std::setw(12) << (timings.wallSeconds * 1e3);
+    out << std::setw(14) << (timings.uploadSeconds * 1e3);
+    out << std::setw(14) << (timings.computeSeconds * 1e3);
+    out << std::setw(12) << timings.numMismatches << std::endl;
+    out.unsetf(std::ios_base::floatfield);
+    out << std::setprecision(6);
+}
+
+void runPipelinedUploadBenchmark(const TestSettings& testSettings, const TestContext& ctx) {
+    sgl::vk::Device* device = ctx.device;
+    const size_t sliceSizeInBytes = PIPELINE_SLICE_ENTRIES * sizeof(float);
+    const auto cs = uint32_t(std::max(testSettings.pipelinedCaseSizeInBytes / sliceSizeInBytes, size_t(1)));
+    const size_t caseSizeInBytes = size_t(cs) * sliceSizeInBytes;
+    const size_t numEntries = caseSizeInBytes / sizeof(float);
+    const uint32_t numCases = std::max(testSettings.pipelinedNumCases, 2u);
+    ctx.out << std::endl;
+    ctx.out
+            << "Pipelined upload benchmark: " << numCases << " cases of "
+            << sgl::getNiceMemoryString(caseSizeInBytes, 2) << std::endl;
+
+    uint32_t uploadQueueFamilyIndex = 0;
+    VkQueue uploadQueue = VK_NULL_HANDLE;
+    // Submitting the uploads to the compute queue itself would serialize them with the compute passes again.
+    const bool hasUploadQueue = findUploadQueue(device, ctx.out, uploadQueueFamilyIndex, uploadQueue);
+    const uint32_t computeQueueFamilyIndex = device->getComputeQueueIndex();
+
+    // Two buffers alternate, so the next case can be uploaded while the compute pass reads the current one.
+    std::vector<sgl::vk::BufferPtr> fieldsBuffers;
+    for (int i = 0; i < 2; i++) {
+        fieldsBuffers.push_back(std::make_shared<sgl::vk::Buffer>(
+                device, caseSizeInBytes,
+                VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT
+                | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+                VMA_MEMORY_USAGE_GPU_ONLY));
+    }
+    auto outputBuffer = std::make_shared<sgl::vk::Buffer>(
+            device, sizeof(uint32_t),
+            VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+            VMA_MEMORY_USAGE_GPU_ONLY);
+    auto outputStagingBuffer = std::make_shared<sgl::vk::Buffer>(
+            device, sizeof(uint32_t), VK_BUFFER_USAGE_TRANSFER_DST_BIT, VMA_MEMORY_USAGE_GPU_TO_CPU);
+
+    auto uploadSemaphore = std::make_shared<sgl::vk::Semaphore>(device, 0, VK_SEMAPHORE_TYPE_TIMELINE, 0);
+    uint64_t uploadTimelineValue = 0;
+    // The passes record into the command buffer of the submitter, so they are created with its renderer.
+    ComputeQueueSubmitter submitter(device);
+    sgl::vk::Renderer* renderer = submitter.getRenderer();
+    GpuTimer gpuTimer(device, 1);
+
+    std::vector<std::shared_ptr<BufferBenchmarkComputePass>> passes;
+    for (const sgl::vk::BufferPtr& fieldsBuffer : fieldsBuffers) {
+        auto pass = std::make_shared<BufferBenchmarkComputePass>(
+                renderer, ctx.shaderCache, PIPELINE_XS, PIPELINE_YS, PIPELINE_ZS, cs,
+                testSettings.benchmarkWorkgroupSize);
+        pass->setTestMode(TestMode::BUFFER_REFERENCE_ARRAY);
+        pass->setDataType(TestDataType::FLOAT);
+        pass->setOutputBuffer(outputBuffer, 0);
+        pass->setFieldsBuffer(fieldsBuffer);
+        passes.push_back(pass);
+    }
+
+    StreamingUploader computeQueueUploader(
+            device, testSettings.streamingChunkSizeInBytes, testSettings.numStreamingChunks);
+    std::unique_ptr<StreamingUploader> uploadQueueUploader;
+    if (hasUploadQueue) {
+        uploadQueueUploader = std::make_unique<StreamingUploader>(
+                device, testSettings.streamingChunkSizeInBytes, testSettings.numStreamingChunks,
+                uploadQueueFamilyIndex, uploadQueue);
+    }
+    auto fillChunk = [&](void* dst, size_t byteOffset, size_t byteSize) {
+        fillFieldsPattern(TestDataType::FLOAT, numEntries, dst, byteOffset, byteSize);
+    };
+
+    auto runPipeline = [&](bool isPipelined) {
+        PipelineTimings timings{};
+        std::vector<uint64_t> uploadTimelineValues(numCases, 0);
+        auto upload = [&](uint32_t caseIdx) {
+            const sgl::vk::BufferPtr& fieldsBuffer = fieldsBuffers.at(caseIdx % 2);
+            UploadStatistics uploadStatistics;
+            if (isPipelined) {
+                // The buffer is not released by the compute queue after the previous read. This is allowed, as the
+                // upload overwrites all of its contents; the CPU wait for the compute pass orders the accesses.
+                uploadTimelineValue++;
+                UploadHandoff handoff{ uploadSemaphore, uploadTimelineValue, computeQueueFamilyIndex };
+                uploadStatistics = uploadQueueUploader->upload(fieldsBuffer, fillChunk, &handoff);
+                uploadTimelineValues.at(caseIdx) = uploadTimelineValue;
+            } else {
+                uploadStatistics = computeQueueUploader.upload(fieldsBuffer, fillChunk);
+            }
+            timings.uploadSeconds += uploadStatistics.timeSeconds;
+            if (caseIdx != 0) {
+                timings.overlappableUploadSeconds += uploadStatistics.timeSeconds;
+            }
+        };
+        auto submitCompute = [&](uint32_t caseIdx) {
+            submitter.begin();
+            VkCommandBuffer commandBuffer = submitter.getVkCommandBuffer();
+            if (isPipelined) {
+                recordQueueFamilyAcquireBarrier(
+                        commandBuffer, fieldsBuffers.at(caseIdx % 2), uploadQueueFamilyIndex, computeQueueFamilyIndex);
+            }
+            outputBuffer->fill(0, commandBuffer);
+            renderer->insertBufferMemoryBarrier(
+                    VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+                    VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                    outputBuffer);
+            gpuTimer.reset(commandBuffer);
+            uint32_t intervalIdx = gpuTimer.begin(commandBuffer);
+            passes.at(caseIdx % 2)->render();
+            gpuTimer.end(commandBuffer, intervalIdx);
+            renderer->insertBufferMemoryBarrier(
+                    VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT,
+                    VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                    outputBuffer);
+            outputBuffer->copyDataTo(outputStagingBuffer, commandBuffer);
+            std::vector<sgl::vk::SemaphorePtr> waitSemaphores;
+            if (isPipelined) {
+                uploadSemaphore->setWaitSemaphoreValue(uploadTimelineValues.at(caseIdx));
+                waitSemaphores.push_back(uploadSemaphore);
+            }
+            submitter.submit(waitSemaphores, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
+        };
+        auto waitCompute = [&]() {
+            submitter.wait();
+            std::vector<double> elapsedTimes = gpuTimer.getElapsedTimesSeconds();
+            if (!elapsedTimes.empty()) {
+                timings.computeSeconds += elapsedTimes.front();
+            }
+            timings.numMismatches += static_cast<uint32_t*>(outputStagingBuffer->mapMemory())[0];
+            outputStagingBuffer->unmapMemory();
+        };
+
+        auto startTime = std::chrono::steady_clock::now();
+        upload(0);
+        for (uint32_t caseIdx = 0; caseIdx < numCases; caseIdx++) {
+            submitCompute(caseIdx);
+            if (isPipelined && caseIdx + 1 < numCases) {
+                upload(caseIdx + 1);
+            }
+            waitCompute();
+            if (!isPipelined && caseIdx + 1 < numCases) {
+                upload(caseIdx + 1);
+            }
+        }
+        timings.wallSeconds = getSecondsSince(startTime);
+        return timings;
+    };
+
+    PipelineTimings serialTimings = runPipeline(false);
+    ctx.out
+            << std::left << std::setw(12) << "Run" << std::right << std::setw(12) << "Wall [ms]"
+            << std::setw(14) << "Upload [ms]" << std::setw(14) << "Compute [ms]" << std::setw(12) << "Mismatches"
+            << std::endl;
+    printRow(ctx.out, "serial", serialTimings);
+    if (!hasUploadQueue) {
+        return;
+    }
+    PipelineTimings pipelinedTimings = runPipeline(true);
+    printRow(ctx.out, "pipelined", pipelinedTimings);
+    // Time in which upload and compute ran at the same time.
+    double hiddenSeconds = std::max(
+            pipelinedTimings.uploadSeconds + pipelinedTimings.computeSeconds - pipelinedTimings.wallSeconds, 0.0);
+    double maxHiddenSeconds = std::min(pipelinedTimings.overlappableUploadSeconds, pipelinedTimings.computeSeconds);
+    ctx.out << "Overlap: " << (hiddenSeconds * 1e3) << "ms hidden";
+    if (maxHiddenSeconds > 0.0) {
+        ctx.out << " (" << std::min(hiddenSeconds / maxHiddenSeconds, 1.0) * 100.0 << "% of the possible overlap)";
+    }
+    if (pipelinedTimings.wallSeconds > 0.0) {
+        ctx.out << ", speedup " << (serialTimings.wallSeconds / pipelinedTimings.wallSeconds);
+    }
+    ctx.out << std::endl;
+}
@@ -0,0 +1,82 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <Graphics/Vulkan/Render/Renderer.hpp>
+
+#include "BufferTestComputePass.hpp"
+#include "ReadBandwidthMeter.hpp"
+
+ReadBandwidthMeter::ReadBandwidthMeter(sgl::vk::Device* device, uint32_t numIterations)
+        : numIterations(numIterations), gpuTimer(device, numIterations), submitter(device) {
+    outputBuffer = std::make_shared<sgl::vk::Buffer>(
+            device, sizeof(uint32_t),
+            VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+            VMA_MEMORY_USAGE_GPU_ONLY);
+    outputStagingBuffer = std::make_shared<sgl::vk::Buffer>(
+            device, sizeof(uint32_t), VK_BUFFER_USAGE_TRANSFER_DST_BIT, VMA_MEMORY_USAGE_GPU_TO_CPU);
+}
+
+ReadMeasurement ReadBandwidthMeter::measure(BufferTestComputePass* pass) {
+    sgl::vk::Renderer* renderer = submitter.getRenderer();
+    VkCommandBuffer commandBuffer = submitter.getVkCommandBuffer();
+    submitter.begin();
+    outputBuffer->fill(0, commandBuffer);
+    gpuTimer.reset(commandBuffer);
+    for (uint32_t iteration = 0; iteration < numIterations; iteration++) {
+        renderer->insertBufferMemoryBarrier(
+                VK_ACCESS_TRANSFER_WRITE_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+                VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+                VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                outputBuffer);
+        uint32_t intervalIdx = gpuTimer.begin(commandBuffer);
+        pass->render();
+        gpuTimer.end(commandBuffer, intervalIdx);
+    }
+    renderer->insertBufferMemoryBarrier(
+            VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+            outputBuffer);
+    outputBuffer->copyDataTo(outputStagingBuffer, commandBuffer);
+    submitter.submitAndWait();
+
+    ReadMeasurement measurement{};
+    std::vector<double> elapsedTimes = gpuTimer.getElapsedTimesSeconds();
+    if (!elapsedTimes.empty()) {
+        double timeSum = 0.0;
+        for (double elapsedTime : elapsedTimes) {
+            timeSum += elapsedTime;
+        }
+        measurement.readSeconds = timeSum / double(elapsedTimes.size());
+    }
+    measurement.outputWord = static_cast<uint32_t*>(outputStagingBuffer->mapMemory())[0];
+    outputStagingBuffer->unmapMemory();
+    // All iterations of a benchmark pass add their mismatches; report the number of a single read.
+    measurement.numMismatches = measurement.outputWord / numIterations;
+    return measurement;
+}
@@ -0,0 +1,65 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef BUFFERTEST64_READBANDWIDTHMETER_HPP
+#define BUFFERTEST64_READBANDWIDTHMETER_HPP
+
+#include <Graphics/Vulkan/Buffers/Buffer.hpp>
+
+#include "GpuTimer.hpp"
+#include "ComputeQueueSubmitter.hpp"
+
+class BufferTestComputePass;
+
+struct ReadMeasurement {
+    double readSeconds = -1.0; // Average over all iterations; negative if timestamps are not supported.
+    uint32_t numMismatches = 0;
+    // First 4 bytes of the output buffer, e.g., the value written by a BufferTestComputePass to output slot 0.
+    uint32_t outputWord = 0;
+};
+
+/**
+ * Runs a pass for multiple iterations in one submission and measures the average GPU time of one iteration. Passes
+ * need to be created with the renderer of the meter and use its output buffer with output slot 0.
+ */
+class ReadBandwidthMeter {
+public:
+    ReadBandwidthMeter(sgl::vk::Device* device, uint32_t numIterations);
+    ReadMeasurement measure(BufferTestComputePass* pass);
+
+    [[nodiscard]] inline sgl::vk::Renderer* getRenderer() { return submitter.getRenderer(); }
+    [[nodiscard]] inline const sgl::vk::BufferPtr& getOutputBuffer() { return outputBuffer; }
+
+private:
+    uint32_t numIterations;
+    GpuTimer gpuTimer;
+    ComputeQueueSubmitter submitter;
+    sgl::vk::BufferPtr outputBuffer, outputStagingBuffer;
+};
+
+#endif //BUFFERTEST64_READBANDWIDTHMETER_HPP
@@ -0,0 +1,181 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cmath>
+#include <cstdio>
+
+#include <Utils/File/Logfile.hpp>
+
+#include "ResultsWriter.hpp"
+
+static std::string escapeJsonString(const std::string& str) {
+    std::string escaped = "\"";
+    for (char c : str) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+            escaped += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char buffer[8];
+            snprintf(buffer, sizeof(buffer), "\\u%04x", int(c));
+            escaped += buffer;
+        } else {
+            escaped += c;
+        }
+    }
+    escaped += "\"";
+    return escaped;
+}
+
+static std::string escapeCsvString(const std::string& str) {
+    if (str.find_first_of(",\"\r\n") == std::string::npos) {
+        return str;
+    }
+    std::string escaped = "\"";
+    for (char c : str) {
+        if (c == '"') {
+            escaped += '"';
+        }
+        escaped += c;
+    }
+    escaped += "\"";
+    return escaped;
+}
+
+/// JSON and CSV have no representation of NaN and infinity; nonFiniteString is written instead.
+static std::string doubleToString(double value, const char* nonFiniteString) {
+    if (!std::isfinite(value)) {
+        return nonFiniteString;
+    }
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%.9g", value);
+    return buffer;
+}
+
+ResultsWriter::ResultsWriter(const std::string& filePath, ResultsFormat format) : format(format) {
+    file.open(filePath, std::ios::out | std::ios::trunc);
+    if (!file.is_open()) {
+        sgl::Logfile::get()->writeError("Error in ResultsWriter::ResultsWriter: Could not open \"" + filePath + "\".");
+        return;
+    }
+    if (format == ResultsFormat::CSV) {
+        writeCsvHeader();
+    }
+}
+
+ResultsWriter::ResultsWriter(const std::string& filePath)
+        : ResultsWriter(
+                filePath, filePath.size() >= 4 && filePath.compare(filePath.size() - 4, 4, ".csv") == 0
+                ? ResultsFormat::CSV : ResultsFormat::JSON_LINES) {
+}
+
+struct DeviceFields {
+    std::string deviceName, driverName, driverVersion, memoryHeaps;
+    uint32_t driverId = 0, vendorId = 0, deviceId = 0;
+};
+
+static DeviceFields getDeviceFields(sgl::vk::Device* device) {
+    DeviceFields fields;
+    fields.deviceName = device->getDeviceName();
+    if (device->getPhysicalDeviceProperties().apiVersion >= VK_API_VERSION_1_1) {
+        fields.driverName = device->getDeviceDriverName();
+        fields.driverId = uint32_t(device->getDeviceDriverId());
+        fields.driverVersion = device->getDriverVersionString();
+    }
+    fields.vendorId = device->getPhysicalDeviceProperties().vendorID;
+    fields.deviceId = device->getPhysicalDeviceProperties().deviceID;
+
+    // Heaps as "<size in bytes>:<flags>" separated by semicolons, with D for device local heaps.
+    const VkPhysicalDeviceMemoryProperties& deviceMemoryProperties = device->getMemoryProperties();
+    for (uint32_t heapIdx = 0; heapIdx < deviceMemoryProperties.memoryHeapCount; heapIdx++) {
+        if (heapIdx != 0) {
+            fields.memoryHeaps += ";";
+        }
+        const VkMemoryHeap& memoryHeap = deviceMemoryProperties.memoryHeaps[heapIdx];
+        fields.memoryHeaps += std::to_string(memoryHeap.size) + ":";
+        fields.memoryHeaps += (memoryHeap.flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0 ? "D" : "H";
+    }
+    return fields;
+}
+
+void ResultsWriter::writeCsvHeader() {
+    file
+            << "device_name,driver_name,driver_id,driver_version,vendor_id,device_id,memory_heaps,"
+            << "test_mode,data_type,allocation,size_bytes,benchmark,passed,value,"
+            << "allocation_s,fill_s,upload_s,shader_compile_s,shader_cached,dispatch_s,readback_s" << std::endl;
+}
+
+void ResultsWriter::writeRecord(sgl::vk::Device* device, const TestRecord& record) {
+    if (!file.is_open()) {
+        return;
+    }
+
+    DeviceFields deviceFields = getDeviceFields(device);
+    std::lock_guard<std::mutex> lock(fileMutex);
+
+    const char* allocationName = record.useHostAllocation ? "host" : "device";
+    if (format == ResultsFormat::JSON_LINES) {
+        file
+                << "{\"device_name\":" << escapeJsonString(deviceFields.deviceName)
+                << ",\"driver_name\":" << escapeJsonString(deviceFields.driverName)
+                << ",\"driver_id\":" << deviceFields.driverId
+                << ",\"driver_version\":" << escapeJsonString(deviceFields.driverVersion)
+                << ",\"vendor_id\":" << deviceFields.vendorId
+                << ",\"device_id\":" << deviceFields.deviceId
+                << ",\"memory_heaps\":" << escapeJsonString(deviceFields.memoryHeaps)
+                << ",\"test_mode\":" << escapeJsonString(TEST_MODE_NAMES[int(record.testMode)])
+                << ",\"data_type\":" << escapeJsonString(TEST_DATA_TYPE_NAMES[int(record.testDataType)])
+                << ",\"allocation\":\"" << allocationName << "\""
+                << ",\"size_bytes\":" << record.sizeInBytes
+                << ",\"benchmark\":" << (record.benchmarkMode ? "true" : "false")
+                << ",\"passed\":" << (record.passed ? "true" : "false")
+                << ",\"value\":" << doubleToString(record.value, "null")
+                << ",\"allocation_s\":" << doubleToString(record.allocationSeconds, "null")
+                << ",\"fill_s\":" << doubleToString(record.fillSeconds, "null")
+                << ",\"upload_s\":" << doubleToString(record.uploadSeconds, "null")
+                << ",\"shader_compile_s\":" << doubleToString(record.shaderCompileSeconds, "null")
+                << ",\"shader_cached\":" << (record.shaderCached ? "true" : "false")
+                << ",\"dispatch_s\":" << doubleToString(record.dispatchSeconds, "null")
+                << ",\"readback_s\":" << doubleToString(record.readbackSeconds, "null")
+                << "}" << std::endl;
+    } else if (format == ResultsFormat::CSV) {
+        file
+                << escapeCsvString(deviceFields.deviceName) << "," << escapeCsvString(deviceFields.driverName) << ","
+                << deviceFields.driverId << "," << escapeCsvString(deviceFields.driverVersion) << ","
+                << deviceFields.vendorId << "," << deviceFields.deviceId << ","
+                << escapeCsvString(deviceFields.memoryHeaps) << ","
+                << escapeCsvString(TEST_MODE_NAMES[int(record.testMode)]) << ","
+                << TEST_DATA_TYPE_NAMES[int(record.testDataType)] << "," << allocationName << ","
+                << record.sizeInBytes << "," << int(record.benchmarkMode) << "," << int(record.passed) << ","
+                << doubleToString(record.value, "") << ","
+                << doubleToString(record.allocationSeconds, "") << "," << doubleToString(record.fillSeconds, "") << ","
+                << doubleToString(record.uploadSeconds, "") << ","
+                << doubleToString(record.shaderCompileSeconds, "") << "," << int(record.shaderCached) << ","
+                << doubleToString(record.dispatchSeconds, "") << "," << doubleToString(record.readbackSeconds, "")
+                << std::endl;
+    }
+}
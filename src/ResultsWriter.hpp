@@ -0,0 +1,92 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef BUFFERTEST64_RESULTSWRITER_HPP
+#define BUFFERTEST64_RESULTSWRITER_HPP
+
+#include <fstream>
+#include <mutex>
+#include <string>
+
+#include <Graphics/Vulkan/Utils/Device.hpp>
+
+#include "TestTypes.hpp"
+
+enum class ResultsFormat {
+    JSON_LINES, CSV
+};
+
+/**
+ * One result record per test mode of a test case. Timings are in seconds and negative if not available. Non-finite
+ * values are written as null in JSON and as empty fields in CSV.
+ */
+struct TestRecord {
+    TestMode testMode = TestMode::STORAGE_BUFFER;
+    TestDataType testDataType = TestDataType::FLOAT;
+    bool useHostAllocation = false;
+    size_t sizeInBytes = 0;
+    bool benchmarkMode = false;
+    bool passed = false;
+    // The value read in test mode and the number of mismatches in benchmark mode.
+    double value = 0.0;
+    // Shared by all test modes of a test case, as they read from the same fields buffer(s).
+    double allocationSeconds = -1.0;
+    double fillSeconds = -1.0;
+    double uploadSeconds = -1.0;
+    // Time of the original compilation, also for shaders taken from the cache, which are marked by shaderCached.
+    double shaderCompileSeconds = -1.0;
+    bool shaderCached = false;
+    // GPU time of the test pass (averaged over all iterations in benchmark mode) and of the output buffer readback.
+    double dispatchSeconds = -1.0;
+    double readbackSeconds = -1.0;
+};
+
+/**
+ * Writes test records as JSON lines or CSV rows, so results can be compared across devices and driver versions without
+ * parsing the free text log. Each record also contains the identification and memory heap layout of its device.
+ * Records are only written by the fixed-size tests and the sweep.
+ * Writing a record is thread-safe; each record is written as a whole.
+ */
+class ResultsWriter {
+public:
+    ResultsWriter(const std::string& filePath, ResultsFormat format);
+    /// Picks CSV for file paths ending in ".csv" and JSON lines otherwise.
+    explicit ResultsWriter(const std::string& filePath);
+    [[nodiscard]] inline bool getIsOpen() const { return file.is_open(); }
+
+    void writeRecord(sgl::vk::Device* device, const TestRecord& record);
+
+private:
+    void writeCsvHeader();
+
+    std::mutex fileMutex;
+    std::ofstream file;
+    ResultsFormat format;
+};
+
+#endif //BUFFERTEST64_RESULTSWRITER_HPP
@@ -0,0 +1,381 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#include <glslang/Public/ShaderLang.h>
+#include <glslang/Public/ResourceLimits.h>
+#include <SPIRV/GlslangToSpv.h>
+
+#include <Utils/AppSettings.hpp>
+#include <Utils/File/Logfile.hpp>
+#include <Utils/File/FileUtils.hpp>
+#include <Graphics/Vulkan/Utils/Device.hpp>
+
+#include "ShaderCache.hpp"
+
+// The GLSL compiler has process-wide state shared by the shader caches of all devices.
+static std::mutex compileMutex;
+
+static const char SPIRV_FILE_MAGIC[8] = { 'B', 'T', '6', '4', 'S', 'P', 'V', '1' };
+
+static bool readFile(const std::string& filePath, std::string& content) {
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    std::ostringstream stream;
+    stream << file.rdbuf();
+    content = stream.str();
+    return !file.bad();
+}
+
+/**
+ * Writes to a temporary file that is then renamed, so that other processes or devices sharing the cache directory never
+ * read a partially written file.
+ */
+static bool writeFileAtomically(const std::string& filePath, const std::string& content) {
+    auto timeStamp = std::chrono::steady_clock::now().time_since_epoch().count();
+    std::string tmpFilePath =
+            filePath + ".tmp" + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()))
+            + "_" + std::to_string(timeStamp);
+    {
+        std::ofstream file(tmpFilePath, std::ios::binary);
+        file.write(content.data(), std::streamsize(content.size()));
+        if (!file.good()) {
+            file.close();
+            std::remove(tmpFilePath.c_str());
+            return false;
+        }
+    }
+    if (std::rename(tmpFilePath.c_str(), filePath.c_str()) != 0) {
+        // Renaming onto an existing file fails on Windows.
+        std::remove(filePath.c_str());
+        if (std::rename(tmpFilePath.c_str(), filePath.c_str()) != 0) {
+            std::remove(tmpFilePath.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+template<class T>
+static void appendValue(std::string& data, const T& value) {
+    data.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<class T>
+static bool readValue(const std::string& data, size_t& offset, T& value) {
+    if (data.size() < offset + sizeof(T)) {
+        return false;
+    }
+    memcpy(&value, data.data() + offset, sizeof(T));
+    offset += sizeof(T);
+    return true;
+}
+
+/// 64-bit FNV-1a hash used for the cache file names. Collisions are detected by comparing the stored key.
+static std::string getKeyHashString(const std::string& key) {
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (char c : key) {
+        hash ^= uint64_t(uint8_t(c));
+        hash *= 0x100000001b3ull;
+    }
+    char hashString[17];
+    snprintf(hashString, sizeof(hashString), "%016llx", static_cast<unsigned long long>(hash));
+    return hashString;
+}
+
+static std::string loadShaderFile(const std::string& fileName) {
+    std::string filePath = sgl::AppSettings::get()->getDataDirectory() + "Shaders/" + fileName;
+    std::string content;
+    if (!readFile(filePath, content)) {
+        sgl::Logfile::get()->throwError("Error in ShaderCache::getShaderStages: Could not read \"" + filePath + "\".");
+    }
+    return content;
+}
+
+/// Appends the lines of the source to the output, replacing '#include "<file>"' lines recursively by the file content.
+static void expandIncludes(const std::string& source, std::string& output, int depth) {
+    if (depth > 16) {
+        sgl::Logfile::get()->throwError("Error in ShaderCache::getShaderStages: Include depth exceeded.");
+    }
+    std::istringstream stream(source);
+    std::string line;
+    while (std::getline(stream, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        size_t start = line.find_first_not_of(" \t");
+        if (start != std::string::npos && line.compare(start, 8, "#include") == 0) {
+            size_t quoteStart = line.find('"', start);
+            size_t quoteEnd = quoteStart == std::string::npos ? std::string::npos : line.find('"', quoteStart + 1);
+            if (quoteEnd == std::string::npos) {
+                sgl::Logfile::get()->throwError(
+                        "Error in ShaderCache::getShaderStages: Malformed include \"" + line + "\".");
+            }
+            expandIncludes(loadShaderFile(line.substr(quoteStart + 1, quoteEnd - quoteStart - 1)), output, depth + 1);
+        } else {
+            output += line;
+            output += '\n';
+        }
+    }
+}
+
+/**
+ * Shader IDs have the format "<file>.<section>". The source of the section follows a line "-- <section>" in
+ * "Data/Shaders/<file>.glsl" and ends at the next section or at the end of the file.
+ */
+std::string ShaderCache::getShaderSource(
+        const std::string& shaderId, const std::map<std::string, std::string>& defines) {
+    size_t dotPos = shaderId.find_last_of('.');
+    if (dotPos == std::string::npos) {
+        sgl::Logfile::get()->throwError(
+                "Error in ShaderCache::getShaderStages: Invalid shader ID \"" + shaderId + "\".");
+    }
+    std::string fileContent = loadShaderFile(shaderId.substr(0, dotPos) + ".glsl");
+    std::string sectionHeader = "-- " + shaderId.substr(dotPos + 1);
+
+    std::string sectionSource;
+    bool isInSection = false, foundSection = false;
+    std::istringstream stream(fileContent);
+    std::string line;
+    while (std::getline(stream, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (line.compare(0, 3, "-- ") == 0) {
+            isInSection = line == sectionHeader;
+            foundSection = foundSection || isInSection;
+        } else if (isInSection) {
+            sectionSource += line;
+            sectionSource += '\n';
+        }
+    }
+    if (!foundSection) {
+        sgl::Logfile::get()->throwError(
+                "Error in ShaderCache::getShaderStages: Could not find the section of \"" + shaderId + "\".");
+    }
+    std::string expandedSource;
+    expandIncludes(sectionSource, expandedSource, 0);
+
+    // The extensions and defines need to follow the #version directive.
+    std::string header;
+    for (const auto& entry : defines) {
+        if (entry.first != "__extensions") {
+            continue;
+        }
+        std::istringstream extensionsStream(entry.second);
+        std::string extension;
+        while (std::getline(extensionsStream, extension, ';')) {
+            header += "#extension " + extension + " : require\n";
+        }
+    }
+    for (const auto& entry : defines) {
+        if (entry.first != "__extensions") {
+            header += "#define " + entry.first + " " + entry.second + "\n";
+        }
+    }
+    size_t versionPos = expandedSource.find("#version");
+    if (versionPos == std::string::npos) {
+        sgl::Logfile::get()->throwError(
+                "Error in ShaderCache::getShaderStages: \"" + shaderId + "\" has no #version directive.");
+    }
+    size_t insertPos = expandedSource.find('\n', versionPos) + 1;
+    expandedSource.insert(insertPos, header);
+    return expandedSource;
+}
+
+std::vector<uint32_t> ShaderCache::compileShader(const std::string& shaderId, const std::string& source) {
+    std::lock_guard<std::mutex> lock(compileMutex);
+    glslang::TShader shader(EShLangCompute);
+    const char* sourceString = source.c_str();
+    const char* sourceName = shaderId.c_str();
+    shader.setStringsWithLengthsAndNames(&sourceString, nullptr, &sourceName, 1);
+    shader.setEnvInput(glslang::EShSourceGlsl, EShLangCompute, glslang::EShClientVulkan, 100);
+    shader.setEnvClient(glslang::EShClientVulkan, targetClientVersion);
+    shader.setEnvTarget(glslang::EShTargetSpv, targetLanguageVersion);
+    const auto messages = EShMessages(EShMsgSpvRules | EShMsgVulkanRules);
+    if (!shader.parse(GetDefaultResources(), 100, false, messages)) {
+        sgl::Logfile::get()->throwError(
+                "Error in ShaderCache::getShaderStages: Compiling \"" + shaderId + "\" failed:\n"
+                + shader.getInfoLog());
+    }
+    glslang::TProgram program;
+    program.addShader(&shader);
+    if (!program.link(messages)) {
+        sgl::Logfile::get()->throwError(
+                "Error in ShaderCache::getShaderStages: Linking \"" + shaderId + "\" failed:\n"
+                + program.getInfoLog());
+    }
+    std::vector<uint32_t> spirv;
+    glslang::GlslangToSpv(*program.getIntermediate(EShLangCompute), spirv);
+    return spirv;
+}
+
+ShaderCache::ShaderCache(sgl::vk::Device* device, bool useDiskCache) : device(device), useDiskCache(useDiskCache) {
+    {
+        std::lock_guard<std::mutex> lock(compileMutex);
+        glslang::InitializeProcess();
+    }
+
+    // The newest SPIR-V version guaranteed to be supported by the API version of the device.
+    const uint32_t apiVersion = device->getPhysicalDeviceProperties().apiVersion;
+    std::string targetName;
+    if (apiVersion >= VK_API_VERSION_1_3) {
+        targetClientVersion = glslang::EShTargetVulkan_1_3;
+        targetLanguageVersion = glslang::EShTargetSpv_1_6;
+        targetName = "Vulkan 1.3, SPIR-V 1.6";
+    } else if (apiVersion >= VK_API_VERSION_1_2) {
+        targetClientVersion = glslang::EShTargetVulkan_1_2;
+        targetLanguageVersion = glslang::EShTargetSpv_1_5;
+        targetName = "Vulkan 1.2, SPIR-V 1.5";
+    } else if (apiVersion >= VK_API_VERSION_1_1) {
+        targetClientVersion = glslang::EShTargetVulkan_1_1;
+        targetLanguageVersion = glslang::EShTargetSpv_1_3;
+        targetName = "Vulkan 1.1, SPIR-V 1.3";
+    } else {
+        targetClientVersion = glslang::EShTargetVulkan_1_0;
+        targetLanguageVersion = glslang::EShTargetSpv_1_0;
+        targetName = "Vulkan 1.0, SPIR-V 1.0";
+    }
+    // Identifies the compiler and the target, so that updating either invalidates the cached SPIR-V code.
+    const glslang::Version version = glslang::GetVersion();
+    compilerTag =
+            "glslang " + std::to_string(version.major) + "." + std::to_string(version.minor) + "."
+            + std::to_string(version.patch) + version.flavor + ", " + targetName;
+
+    if (useDiskCache) {
+        cacheDirectory = sgl::FileUtils::get()->getConfigDirectory() + "ShaderCache/";
+        sgl::FileUtils::get()->ensureDirectoryExists(cacheDirectory);
+    }
+}
+
+ShaderCache::~ShaderCache() {
+    std::lock_guard<std::mutex> lock(compileMutex);
+    glslang::FinalizeProcess();
+}
+
+sgl::vk::ShaderStagesPtr ShaderCache::getShaderStages(
+        const std::string& shaderId, const std::map<std::string, std::string>& preprocessorDefines) {
+    std::string variantKey = shaderId;
+    for (const auto& entry : preprocessorDefines) {
+        variantKey += "\n" + entry.first + "=" + entry.second;
+    }
+    auto it = shaderStagesMap.find(variantKey);
+    if (it != shaderStagesMap.end()) {
+        numHits++;
+        lookupCompileTimeSeconds += it->second.compileTimeSeconds;
+        return it->second.shaderStages;
+    }
+
+    // The disk cache is keyed by the preprocessed source, so changes to the shader files or includes invalidate it.
+    auto startTime = std::chrono::steady_clock::now();
+    std::string source = getShaderSource(shaderId, preprocessorDefines);
+    std::string diskKey = shaderId + "\n" + compilerTag + "\n" + source;
+    std::vector<uint32_t> spirv;
+    double originalCompileTimeSeconds = 0.0;
+    bool isDiskHit = useDiskCache && loadSpirv(diskKey, spirv, originalCompileTimeSeconds);
+    if (!isDiskHit) {
+        spirv = compileShader(shaderId, source);
+    }
+    auto shaderModule = std::make_shared<sgl::vk::ShaderModule>(
+            device, shaderId, sgl::vk::ShaderModuleType::COMPUTE, spirv);
+    std::vector<sgl::vk::ShaderModulePtr> shaderModules = { shaderModule };
+    auto shaderStages = std::make_shared<sgl::vk::ShaderStages>(device, shaderModules);
+    auto endTime = std::chrono::steady_clock::now();
+    double entryTimeSeconds = std::chrono::duration<double>(endTime - startTime).count();
+
+    if (isDiskHit) {
+        numDiskHits++;
+    } else {
+        numMisses++;
+        originalCompileTimeSeconds = entryTimeSeconds;
+        if (useDiskCache) {
+            saveSpirv(diskKey, spirv, originalCompileTimeSeconds);
+        }
+    }
+    compileTimeSeconds += entryTimeSeconds;
+    lookupCompileTimeSeconds += originalCompileTimeSeconds;
+    shaderStagesMap.insert(std::make_pair(variantKey, CacheEntry{ shaderStages, originalCompileTimeSeconds }));
+    return shaderStages;
+}
+
+/*
+ * SPIR-V cache file layout: magic, key size (uint64_t), key, original compile time in seconds (double),
+ * number of SPIR-V words (uint64_t), SPIR-V words.
+ */
+bool ShaderCache::loadSpirv(const std::string& key, std::vector<uint32_t>& spirv, double& originalCompileTimeSeconds) {
+    std::string data;
+    if (!readFile(cacheDirectory + getKeyHashString(key) + ".spv", data)) {
+        return false;
+    }
+    size_t offset = sizeof(SPIRV_FILE_MAGIC);
+    uint64_t keySize = 0, numWords = 0;
+    if (data.size() < offset || memcmp(data.data(), SPIRV_FILE_MAGIC, sizeof(SPIRV_FILE_MAGIC)) != 0
+            || !readValue(data, offset, keySize) || data.size() - offset < keySize
+            || data.compare(offset, size_t(keySize), key) != 0) {
+        return false;
+    }
+    offset += size_t(keySize);
+    if (!readValue(data, offset, originalCompileTimeSeconds) || !readValue(data, offset, numWords)
+            || numWords == 0 || (data.size() - offset) / sizeof(uint32_t) != numWords
+            || (data.size() - offset) % sizeof(uint32_t) != 0) {
+        return false;
+    }
+    spirv.resize(size_t(numWords));
+    memcpy(spirv.data(), data.data() + offset, size_t(numWords) * sizeof(uint32_t));
+    return true;
+}
+
+void ShaderCache::saveSpirv(
+        const std::string& key, const std::vector<uint32_t>& spirv, double originalCompileTimeSeconds) {
+    std::string data(SPIRV_FILE_MAGIC, sizeof(SPIRV_FILE_MAGIC));
+    appendValue(data, uint64_t(key.size()));
+    data += key;
+    appendValue(data, originalCompileTimeSeconds);
+    appendValue(data, uint64_t(spirv.size()));
+    data.append(reinterpret_cast<const char*>(spirv.data()), spirv.size() * sizeof(uint32_t));
+    if (!writeFileAtomically(cacheDirectory + getKeyHashString(key) + ".spv", data)) {
+        sgl::Logfile::get()->writeWarning(
+                "Warning in ShaderCache::saveSpirv: Could not write to \"" + cacheDirectory + "\".", false);
+    }
+}
+
+void ShaderCache::printStatistics(std::ostream& out) const {
+    out
+            << "Shader cache: " << numHits << " hits, " << numDiskHits << " disk hits, " << numMisses << " misses ("
+            << (compileTimeSeconds * 1e3) << "ms load and compile time)" << std::endl;
+}
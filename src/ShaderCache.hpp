@@ -0,0 +1,101 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef BUFFERTEST64_SHADERCACHE_HPP
+#define BUFFERTEST64_SHADERCACHE_HPP
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <glslang/Public/ShaderLang.h>
+#include <Graphics/Vulkan/Shader/Shader.hpp>
+
+namespace sgl { namespace vk {
+class Device;
+}}
+
+/**
+ * Caches compiled shader stages by shader ID and the full set of preprocessor defines (which includes the GLSL
+ * extensions passed via "__extensions"). Each variant is compiled at most once per device and process. Unless the disk
+ * cache is disabled, the SPIR-V code of each variant is also stored in the shader cache directory, keyed by the fully
+ * preprocessed source and the compiler target, so warm runs skip the GLSL compiler. The sgl shader manager does not
+ * expose the SPIR-V code it compiles, so the variants are compiled here with the glslang library the program links.
+ * Pipeline creation stays in sgl, which does not take a VkPipelineCache; the on-disk shader caches of the drivers
+ * cover this step.
+ */
+class ShaderCache {
+public:
+    ShaderCache(sgl::vk::Device* device, bool useDiskCache);
+    ~ShaderCache();
+    ShaderCache(const ShaderCache&) = delete;
+    ShaderCache& operator=(const ShaderCache&) = delete;
+
+    sgl::vk::ShaderStagesPtr getShaderStages(
+            const std::string& shaderId, const std::map<std::string, std::string>& preprocessorDefines);
+
+    [[nodiscard]] inline size_t getNumHits() const { return numHits; }
+    [[nodiscard]] inline size_t getNumDiskHits() const { return numDiskHits; }
+    /// Number of variants compiled with the GLSL compiler, i.e., found neither in memory nor on disk.
+    [[nodiscard]] inline size_t getNumMisses() const { return numMisses; }
+    /// Time spent loading or compiling the variants not found in memory.
+    [[nodiscard]] inline double getCompileTimeSeconds() const { return compileTimeSeconds; }
+    /// Sum of the original compile times of all looked-up variants, including the ones served from the cache.
+    [[nodiscard]] inline double getLookupCompileTimeSeconds() const { return lookupCompileTimeSeconds; }
+    void printStatistics(std::ostream& out) const;
+
+private:
+    std::string getShaderSource(const std::string& shaderId, const std::map<std::string, std::string>& defines);
+    std::vector<uint32_t> compileShader(const std::string& shaderId, const std::string& source);
+    bool loadSpirv(const std::string& key, std::vector<uint32_t>& spirv, double& originalCompileTimeSeconds);
+    void saveSpirv(const std::string& key, const std::vector<uint32_t>& spirv, double originalCompileTimeSeconds);
+
+    sgl::vk::Device* device;
+    bool useDiskCache;
+    // Vulkan and SPIR-V target of the compiler, derived from the API version of the device.
+    glslang::EShTargetClientVersion targetClientVersion;
+    glslang::EShTargetLanguageVersion targetLanguageVersion;
+    std::string compilerTag;
+    std::string cacheDirectory;
+
+    struct CacheEntry {
+        sgl::vk::ShaderStagesPtr shaderStages;
+        double compileTimeSeconds = 0.0;
+    };
+    std::map<std::string, CacheEntry> shaderStagesMap;
+    size_t numHits = 0;
+    size_t numDiskHits = 0;
+    size_t numMisses = 0;
+    double compileTimeSeconds = 0.0;
+    double lookupCompileTimeSeconds = 0.0;
+};
+
+#endif //BUFFERTEST64_SHADERCACHE_HPP
@@ -0,0 +1,171 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+
+#include <Graphics/Vulkan/Utils/Device.hpp>
+#include <Graphics/Vulkan/Buffers/Buffer.hpp>
+#include <ImGui/Widgets/NumberFormatting.hpp>
+
+#include "Timing.hpp"
+#include "ReadBandwidthMeter.hpp"
+#include "FieldsGeneratorPass.hpp"
+#include "BufferBenchmarkComputePass.hpp"
+#include "SparseBuffer.hpp"
+#include "SparseBenchmark.hpp"
+
+static const uint32_t SPARSE_XS = 512;
+static const uint32_t SPARSE_YS = 512;
+static const uint32_t SPARSE_ZS = 512;
+static const uint32_t SPARSE_CS = 10; // 5GiB of floats.
+static const size_t SPARSE_VERIFICATION_NUM_SAMPLES = 1024;
+
+/// Fills the buffer on the GPU and measures the read bandwidth of all passed test modes.
+static std::vector<ReadMeasurement> measureTestModes(
+        const TestSettings& testSettings, const TestContext& ctx, const std::vector<TestMode>& testModes,
+        const sgl::vk::BufferPtr& fieldsBuffer, size_t numEntries) {
+    generateFieldsPattern(ctx, TestDataType::FLOAT, fieldsBuffer, numEntries);
+    size_t numMismatches = verifyFieldsPattern(
+            ctx, TestDataType::FLOAT, fieldsBuffer, numEntries, SPARSE_VERIFICATION_NUM_SAMPLES);
+    if (numMismatches != 0) {
+        ctx.out
+                << numMismatches << " of " << SPARSE_VERIFICATION_NUM_SAMPLES
+                << " samples of the generated buffer mismatching" << std::endl;
+    }
+
+    ReadBandwidthMeter meter(ctx.device, std::max(testSettings.benchmarkNumIterations, 1u));
+    std::vector<ReadMeasurement> measurements;
+    for (TestMode testMode : testModes) {
+        auto pass = std::make_shared<BufferBenchmarkComputePass>(
+                meter.getRenderer(), ctx.shaderCache, SPARSE_XS, SPARSE_YS, SPARSE_ZS, SPARSE_CS,
+                testSettings.benchmarkWorkgroupSize);
+        pass->setTestMode(testMode);
+        pass->setDataType(TestDataType::FLOAT);
+        pass->setFieldsBuffer(fieldsBuffer);
+        pass->setOutputBuffer(meter.getOutputBuffer(), 0);
+        measurements.push_back(meter.measure(pass.get()));
+    }
+    return measurements;
+}
+
+static void printBandwidth(std::ostream& out, size_t sizeInBytes, const ReadMeasurement* measurement) {
+    if (measurement && measurement->readSeconds > 0.0) {
+        out << std::setw(16) << (double(sizeInBytes) / measurement->readSeconds * 1e-9);
+    } else {
+        out << std::setw(16) << "-";
+    }
+}
+
+void runSparseBenchmark(const TestSettings& testSettings, const TestContext& ctx) {
+    sgl::vk::Device* device = ctx.device;
+    if (!SparseBuffer::getIsSupported(device)) {
+        ctx.out << "Sparse benchmark: Sparse binding is not supported." << std::endl;
+        return;
+    }
+    std::vector<TestMode> testModes;
+    for (int i = 0; i < NUM_TESTS; i++) {
+        if (!device->getShader64BitIndexingFeaturesEXT().shader64BitIndexing
+                && i >= int(TestMode::STORAGE_BUFFER_64_BIT)) {
+            break;
+        }
+        if (!TEST_MODE_USES_ARRAY[i] && testSettings.testPlan.getIsTestModeSelected(TestMode(i))) {
+            testModes.push_back(TestMode(i));
+        }
+    }
+    const size_t numEntries = size_t(SPARSE_XS) * size_t(SPARSE_YS) * size_t(SPARSE_ZS) * size_t(SPARSE_CS);
+    const size_t sizeInBytes = numEntries * sizeof(float);
+    const VkBufferUsageFlags usage =
+            VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT
+            | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+    ctx.out << std::endl;
+    ctx.out << "Sparse benchmark: " << sgl::getNiceMemoryString(sizeInBytes, 2) << std::endl;
+
+    // The buffers are measured one after the other, so both do not need to fit into device memory at once.
+    std::vector<ReadMeasurement> dedicatedMeasurements;
+    {
+        sgl::vk::BufferPtr dedicatedBuffer;
+        auto startTime = std::chrono::steady_clock::now();
+        try {
+            dedicatedBuffer = std::make_shared<sgl::vk::Buffer>(device, sizeInBytes, usage, VMA_MEMORY_USAGE_GPU_ONLY);
+            double allocationSeconds = getSecondsSince(startTime);
+            ctx.out << "Dedicated allocation: " << (allocationSeconds * 1e3) << "ms" << std::endl;
+        } catch (const std::exception& e) {
+            ctx.out << "Dedicated allocation failed: " << e.what() << std::endl;
+        }
+        if (dedicatedBuffer) {
+            dedicatedMeasurements = measureTestModes(testSettings, ctx, testModes, dedicatedBuffer, numEntries);
+        }
+    }
+
+    std::vector<ReadMeasurement> sparseMeasurements;
+    {
+        std::unique_ptr<SparseBuffer> sparseBuffer;
+        try {
+            sparseBuffer = std::make_unique<SparseBuffer>(
+                    device, sizeInBytes, testSettings.sparseBlockSizeInBytes, usage);
+            ctx.out
+                    << "Sparse buffer: " << sparseBuffer->getNumMemoryBlocks() << " blocks of "
+                    << sgl::getNiceMemoryString(sparseBuffer->getBlockSizeInBytes(), 2) << ", allocation "
+                    << (sparseBuffer->getAllocationSeconds() * 1e3) << "ms, bind "
+                    << (sparseBuffer->getBindSeconds() * 1e3) << "ms" << std::endl;
+        } catch (const std::exception& e) {
+            ctx.out << "Sparse allocation failed: " << e.what() << std::endl;
+        }
+        if (sparseBuffer) {
+            sparseMeasurements = measureTestModes(
+                    testSettings, ctx, testModes, sparseBuffer->getBuffer(), numEntries);
+        }
+    }
+
+    ctx.out
+            << std::left << std::setw(34) << "Test mode" << std::right << std::setw(16) << "Dedicated GB/s"
+            << std::setw(16) << "Sparse GB/s" << std::setw(10) << "Ratio" << std::setw(12) << "Mismatches"
+            << std::endl;
+    ctx.out << std::fixed << std::setprecision(2);
+    for (size_t i = 0; i < testModes.size(); i++) {
+        const ReadMeasurement* dedicated = i < dedicatedMeasurements.size() ? &dedicatedMeasurements.at(i) : nullptr;
+        const ReadMeasurement* sparse = i < sparseMeasurements.size() ? &sparseMeasurements.at(i) : nullptr;
+        ctx.out << std::left << std::setw(34) << TEST_MODE_NAMES[int(testModes.at(i))] << std::right;
+        printBandwidth(ctx.out, sizeInBytes, dedicated);
+        printBandwidth(ctx.out, sizeInBytes, sparse);
+        if (dedicated && sparse && dedicated->readSeconds > 0.0 && sparse->readSeconds > 0.0) {
+            ctx.out << std::setw(10) << (dedicated->readSeconds / sparse->readSeconds);
+        } else {
+            ctx.out << std::setw(10) << "-";
+        }
+        // Mismatches of the sparse buffer, as the dedicated allocation is the reference.
+        if (sparse) {
+            ctx.out << std::setw(12) << sparse->numMismatches << std::endl;
+        } else {
+            ctx.out << std::setw(12) << "-" << std::endl;
+        }
+    }
+    ctx.out.unsetf(std::ios_base::floatfield);
+    ctx.out << std::setprecision(6);
+}
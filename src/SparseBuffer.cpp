@@ -0,0 +1,179 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <algorithm>
+#include <chrono>
+
+#include <Utils/File/Logfile.hpp>
+#include <Graphics/Vulkan/Utils/Device.hpp>
+#include <Graphics/Vulkan/Utils/SyncObjects.hpp>
+
+#include "Timing.hpp"
+#include "SparseBuffer.hpp"
+
+/// Returns the compute queue if it supports sparse binding, otherwise the graphics queue if it does, or null.
+static VkQueue getSparseBindingQueue(sgl::vk::Device* device) {
+    uint32_t queueFamilyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(device->getVkPhysicalDevice(), &queueFamilyCount, nullptr);
+    std::vector<VkQueueFamilyProperties> queueFamilyProperties(queueFamilyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(
+            device->getVkPhysicalDevice(), &queueFamilyCount, queueFamilyProperties.data());
+    if ((queueFamilyProperties.at(device->getComputeQueueIndex()).queueFlags & VK_QUEUE_SPARSE_BINDING_BIT) != 0) {
+        return device->getComputeQueue();
+    }
+    if ((queueFamilyProperties.at(device->getGraphicsQueueIndex()).queueFlags & VK_QUEUE_SPARSE_BINDING_BIT) != 0) {
+        return device->getGraphicsQueue();
+    }
+    return VK_NULL_HANDLE;
+}
+
+bool SparseBuffer::getIsSupported(sgl::vk::Device* device) {
+    return device->getPhysicalDeviceFeatures().sparseBinding && getSparseBindingQueue(device) != VK_NULL_HANDLE;
+}
+
+SparseBuffer::SparseBuffer(
+        sgl::vk::Device* device, size_t sizeInBytes, size_t blockSizeInBytes, VkBufferUsageFlags usage)
+        : device(device) {
+    VkDevice vkDevice = device->getVkDevice();
+    VkQueue sparseBindingQueue = getSparseBindingQueue(device);
+    if (!device->getPhysicalDeviceFeatures().sparseBinding || !sparseBindingQueue) {
+        sgl::Logfile::get()->throwError("Error in SparseBuffer::SparseBuffer: Sparse binding is not supported.");
+    }
+
+    VkBufferCreateInfo bufferCreateInfo{};
+    bufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferCreateInfo.flags = VK_BUFFER_CREATE_SPARSE_BINDING_BIT;
+    bufferCreateInfo.size = sizeInBytes;
+    bufferCreateInfo.usage = usage;
+    bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    VkBuffer vkBuffer = VK_NULL_HANDLE;
+    if (vkCreateBuffer(vkDevice, &bufferCreateInfo, nullptr, &vkBuffer) != VK_SUCCESS) {
+        sgl::Logfile::get()->throwError("Error in SparseBuffer::SparseBuffer: Could not create a buffer.");
+    }
+    // No device memory is passed, so the sgl buffer only destroys its VkBuffer and the sparse buffer frees the blocks.
+    buffer = std::make_shared<sgl::vk::Buffer>(device, sizeInBytes, vkBuffer, VK_NULL_HANDLE, usage);
+
+    // For sparse resources, the alignment is the sparse block size, and all binds need to be multiples of it.
+    VkMemoryRequirements memoryRequirements{};
+    vkGetBufferMemoryRequirements(vkDevice, vkBuffer, &memoryRequirements);
+    const VkDeviceSize granularity = memoryRequirements.alignment;
+    VkDeviceSize maxBlockSize = device->getPhysicalDeviceVulkan11Properties().maxMemoryAllocationSize;
+    maxBlockSize = std::max(maxBlockSize / granularity * granularity, granularity);
+    VkDeviceSize blockSize = (VkDeviceSize(blockSizeInBytes) + granularity - 1) / granularity * granularity;
+    blockSize = std::max(blockSize, granularity);
+    // Leave half of maxMemoryAllocationCount (often 4096 on Windows) to the other allocations of the process.
+    const VkDeviceSize maxNumBlocks = std::max(device->getLimits().maxMemoryAllocationCount / 2u, 1u);
+    if ((memoryRequirements.size + blockSize - 1) / blockSize > maxNumBlocks) {
+        blockSize = (memoryRequirements.size + maxNumBlocks - 1) / maxNumBlocks;
+        blockSize = (blockSize + granularity - 1) / granularity * granularity;
+    }
+    if (blockSize > maxBlockSize && (memoryRequirements.size + maxBlockSize - 1) / maxBlockSize > maxNumBlocks) {
+        buffer = {};
+        sgl::Logfile::get()->throwError(
+                "Error in SparseBuffer::SparseBuffer: The buffer needs more blocks than maxMemoryAllocationCount "
+                "allows.");
+    }
+    blockSize = std::min(blockSize, maxBlockSize);
+    this->blockSizeInBytes = size_t(blockSize);
+
+    // Prefer device-local types that are not host visible, so the blocks don't come from a (Re)BAR heap.
+    const VkPhysicalDeviceMemoryProperties& deviceMemoryProperties = device->getMemoryProperties();
+    uint32_t memoryTypeIndex = deviceMemoryProperties.memoryTypeCount;
+    for (int pass = 0; pass < 2 && memoryTypeIndex == deviceMemoryProperties.memoryTypeCount; pass++) {
+        const VkMemoryPropertyFlags excludedFlags = pass == 0 ? VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT : 0;
+        for (uint32_t i = 0; i < deviceMemoryProperties.memoryTypeCount; i++) {
+            const VkMemoryPropertyFlags propertyFlags = deviceMemoryProperties.memoryTypes[i].propertyFlags;
+            if ((memoryRequirements.memoryTypeBits & (1u << i)) != 0
+                    && (propertyFlags & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT) != 0
+                    && (propertyFlags & excludedFlags) == 0) {
+                memoryTypeIndex = i;
+                break;
+            }
+        }
+    }
+    if (memoryTypeIndex == deviceMemoryProperties.memoryTypeCount) {
+        sgl::Logfile::get()->throwError("Error in SparseBuffer::SparseBuffer: No device local memory type found.");
+    }
+
+    VkMemoryAllocateFlagsInfo memoryAllocateFlagsInfo{};
+    memoryAllocateFlagsInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO;
+    if ((usage & VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT) != 0) {
+        memoryAllocateFlagsInfo.flags = VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT;
+    }
+    std::vector<VkSparseMemoryBind> sparseMemoryBinds;
+    auto startTime = std::chrono::steady_clock::now();
+    for (VkDeviceSize offset = 0; offset < memoryRequirements.size; offset += blockSize) {
+        VkMemoryAllocateInfo memoryAllocateInfo{};
+        memoryAllocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        memoryAllocateInfo.pNext = &memoryAllocateFlagsInfo;
+        memoryAllocateInfo.allocationSize = std::min(blockSize, memoryRequirements.size - offset);
+        memoryAllocateInfo.memoryTypeIndex = memoryTypeIndex;
+        VkDeviceMemory memoryBlock = VK_NULL_HANDLE;
+        if (vkAllocateMemory(vkDevice, &memoryAllocateInfo, nullptr, &memoryBlock) != VK_SUCCESS) {
+            freeMemoryBlocks();
+            buffer = {};
+            sgl::Logfile::get()->throwError("Error in SparseBuffer::SparseBuffer: Could not allocate a memory block.");
+        }
+        memoryBlocks.push_back(memoryBlock);
+        VkSparseMemoryBind sparseMemoryBind{};
+        sparseMemoryBind.resourceOffset = offset;
+        sparseMemoryBind.size = memoryAllocateInfo.allocationSize;
+        sparseMemoryBind.memory = memoryBlock;
+        sparseMemoryBinds.push_back(sparseMemoryBind);
+    }
+    allocationSeconds = getSecondsSince(startTime);
+
+    VkSparseBufferMemoryBindInfo sparseBufferMemoryBindInfo{};
+    sparseBufferMemoryBindInfo.buffer = vkBuffer;
+    sparseBufferMemoryBindInfo.bindCount = uint32_t(sparseMemoryBinds.size());
+    sparseBufferMemoryBindInfo.pBinds = sparseMemoryBinds.data();
+    VkBindSparseInfo bindSparseInfo{};
+    bindSparseInfo.sType = VK_STRUCTURE_TYPE_BIND_SPARSE_INFO;
+    bindSparseInfo.bufferBindCount = 1;
+    bindSparseInfo.pBufferBinds = &sparseBufferMemoryBindInfo;
+    sgl::vk::Fence fence(device);
+    startTime = std::chrono::steady_clock::now();
+    if (vkQueueBindSparse(sparseBindingQueue, 1, &bindSparseInfo, fence.getVkFence()) != VK_SUCCESS) {
+        freeMemoryBlocks();
+        buffer = {};
+        sgl::Logfile::get()->throwError("Error in SparseBuffer::SparseBuffer: vkQueueBindSparse failed.");
+    }
+    fence.wait();
+    bindSeconds = getSecondsSince(startTime);
+}
+
+SparseBuffer::~SparseBuffer() {
+    buffer = {};
+    freeMemoryBlocks();
+}
+
+void SparseBuffer::freeMemoryBlocks() {
+    for (VkDeviceMemory memoryBlock : memoryBlocks) {
+        vkFreeMemory(device->getVkDevice(), memoryBlock, nullptr);
+    }
+    memoryBlocks.clear();
+}
@@ -0,0 +1,74 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef BUFFERTEST64_SPARSEBUFFER_HPP
+#define BUFFERTEST64_SPARSEBUFFER_HPP
+
+#include <vector>
+
+#include <Graphics/Vulkan/Buffers/Buffer.hpp>
+
+/**
+ * A buffer created with VK_BUFFER_CREATE_SPARSE_BINDING_BIT that is backed by many device-local memory blocks bound
+ * with vkQueueBindSparse, so its size is not limited by maxMemoryAllocationSize. The blocks are bound once at
+ * creation and are owned by the sparse buffer, so it needs to outlive all uses of its buffer.
+ */
+class SparseBuffer {
+public:
+    /**
+     * blockSizeInBytes is rounded up to the sparse binding granularity and capped at maxMemoryAllocationSize. It is
+     * increased if the buffer would need more than half of maxMemoryAllocationCount blocks; throws if even blocks of
+     * maxMemoryAllocationSize are too many.
+     */
+    SparseBuffer(sgl::vk::Device* device, size_t sizeInBytes, size_t blockSizeInBytes, VkBufferUsageFlags usage);
+    ~SparseBuffer();
+    SparseBuffer(const SparseBuffer&) = delete;
+    SparseBuffer& operator=(const SparseBuffer&) = delete;
+
+    /// Whether the sparseBinding feature is enabled and the compute or graphics queue supports sparse binding.
+    static bool getIsSupported(sgl::vk::Device* device);
+
+    [[nodiscard]] inline const sgl::vk::BufferPtr& getBuffer() const { return buffer; }
+    [[nodiscard]] inline size_t getNumMemoryBlocks() const { return memoryBlocks.size(); }
+    [[nodiscard]] inline size_t getBlockSizeInBytes() const { return blockSizeInBytes; }
+    /// Time for allocating all memory blocks.
+    [[nodiscard]] inline double getAllocationSeconds() const { return allocationSeconds; }
+    /// Time from vkQueueBindSparse until the bind fence is signaled.
+    [[nodiscard]] inline double getBindSeconds() const { return bindSeconds; }
+
+private:
+    void freeMemoryBlocks();
+
+    sgl::vk::Device* device;
+    sgl::vk::BufferPtr buffer;
+    std::vector<VkDeviceMemory> memoryBlocks;
+    size_t blockSizeInBytes = 0;
+    double allocationSeconds = 0.0;
+    double bindSeconds = 0.0;
+};
+
+#endif //BUFFERTEST64_SPARSEBUFFER_HPP
@@ -0,0 +1,318 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <chrono>
+
+#include <Utils/File/Logfile.hpp>
+#include <Graphics/Vulkan/Utils/Device.hpp>
+#include <ImGui/Widgets/NumberFormatting.hpp>
+
+#include "Timing.hpp"
+#include "StreamingDownload.hpp"
+
+double DownloadStatistics::getBandwidthGBs() const {
+    if (timeSeconds <= 0.0) {
+        return 0.0;
+    }
+    return double(sizeInBytes) / timeSeconds * 1e-9;
+}
+
+StreamingDownloader::StreamingDownloader(
+        sgl::vk::Device* device, size_t chunkSizeInBytes, uint32_t numStagingChunks, uint32_t memoryTypeIndex)
+        : device(device), chunkSizeInBytes(chunkSizeInBytes), numStagingChunks(numStagingChunks) {
+    if (chunkSizeInBytes == 0 || numStagingChunks == 0) {
+        sgl::Logfile::get()->throwError(
+                "Error in StreamingDownloader::StreamingDownloader: The chunk size and number of chunks must be "
+                "non-zero.");
+    }
+    const VkMemoryPropertyFlags memoryPropertyFlags =
+            device->getMemoryProperties().memoryTypes[memoryTypeIndex].propertyFlags;
+    if ((memoryPropertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) == 0) {
+        sgl::Logfile::get()->throwError(
+                "Error in StreamingDownloader::StreamingDownloader: The memory type is not host visible.");
+    }
+    isHostCoherent = (memoryPropertyFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) != 0;
+
+    // The destructor does not run if the constructor throws, so the chunks created so far are released here.
+    try {
+        createStagingChunks(memoryTypeIndex);
+    } catch (...) {
+        release();
+        throw;
+    }
+}
+
+void StreamingDownloader::createStagingChunks(uint32_t memoryTypeIndex) {
+    VkDevice vkDevice = device->getVkDevice();
+    sgl::vk::CommandPoolType commandPoolType{};
+    commandPoolType.queueFamilyIndex = device->getComputeQueueIndex();
+    commandPoolType.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+    // VMA only selects memory types by usage, so the staging chunks are allocated manually like the arena blocks.
+    for (uint32_t i = 0; i < numStagingChunks; i++) {
+        VkBufferCreateInfo bufferCreateInfo{};
+        bufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        bufferCreateInfo.size = chunkSizeInBytes;
+        bufferCreateInfo.usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+        bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        VkBuffer vkBuffer = VK_NULL_HANDLE;
+        if (vkCreateBuffer(vkDevice, &bufferCreateInfo, nullptr, &vkBuffer) != VK_SUCCESS) {
+            sgl::Logfile::get()->throwError(
+                    "Error in StreamingDownloader::StreamingDownloader: Could not create a staging buffer.");
+        }
+        // No device memory is passed, so the sgl buffer only destroys its VkBuffer and the memory is freed in release.
+        auto stagingBuffer = std::make_shared<sgl::vk::Buffer>(
+                device, chunkSizeInBytes, vkBuffer, VK_NULL_HANDLE, VK_BUFFER_USAGE_TRANSFER_DST_BIT);
+        stagingBuffers.push_back(stagingBuffer);
+
+        VkMemoryRequirements memoryRequirements{};
+        vkGetBufferMemoryRequirements(vkDevice, vkBuffer, &memoryRequirements);
+        if ((memoryRequirements.memoryTypeBits & (1u << memoryTypeIndex)) == 0) {
+            sgl::Logfile::get()->throwError(
+                    "Error in StreamingDownloader::StreamingDownloader: The memory type is not usable for buffers.");
+        }
+        VkMemoryAllocateInfo memoryAllocateInfo{};
+        memoryAllocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        memoryAllocateInfo.allocationSize = memoryRequirements.size;
+        memoryAllocateInfo.memoryTypeIndex = memoryTypeIndex;
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        if (vkAllocateMemory(vkDevice, &memoryAllocateInfo, nullptr, &memory) != VK_SUCCESS) {
+            sgl::Logfile::get()->throwError(
+                    "Error in StreamingDownloader::StreamingDownloader: Could not allocate staging memory.");
+        }
+        stagingMemory.push_back(memory);
+        if (vkBindBufferMemory(vkDevice, vkBuffer, memory, 0) != VK_SUCCESS) {
+            sgl::Logfile::get()->throwError(
+                    "Error in StreamingDownloader::StreamingDownloader: Could not bind staging memory.");
+        }
+        void* mappedPtr = nullptr;
+        if (vkMapMemory(vkDevice, memory, 0, VK_WHOLE_SIZE, 0, &mappedPtr) != VK_SUCCESS) {
+            sgl::Logfile::get()->throwError(
+                    "Error in StreamingDownloader::StreamingDownloader: Could not map staging memory.");
+        }
+        stagingBuffersMapped.push_back(mappedPtr);
+
+        fences.push_back(std::make_shared<sgl::vk::Fence>(device));
+        commandBuffers.push_back(device->allocateCommandBuffer(commandPoolType, &commandPool));
+    }
+}
+
+StreamingDownloader::~StreamingDownloader() {
+    release();
+}
+
+void StreamingDownloader::release() {
+    for (VkCommandBuffer commandBuffer : commandBuffers) {
+        device->freeCommandBuffer(commandPool, commandBuffer);
+    }
+    commandBuffers.clear();
+    fences.clear();
+    stagingBuffers.clear();
+    for (size_t i = 0; i < stagingMemory.size(); i++) {
+        if (i < stagingBuffersMapped.size()) {
+            vkUnmapMemory(device->getVkDevice(), stagingMemory[i]);
+        }
+        vkFreeMemory(device->getVkDevice(), stagingMemory[i], nullptr);
+    }
+    stagingMemory.clear();
+    stagingBuffersMapped.clear();
+}
+
+DownloadStatistics StreamingDownloader::download(
+        const sgl::vk::BufferPtr& srcBuffer, const ConsumeChunkFunction& consumeChunk) {
+    DownloadStatistics downloadStatistics{};
+    downloadStatistics.sizeInBytes = srcBuffer->getSizeInBytes();
+    downloadStatistics.chunkSizeInBytes = chunkSizeInBytes;
+    downloadStatistics.numStagingChunks = numStagingChunks;
+    const size_t sizeInBytes = srcBuffer->getSizeInBytes();
+    const size_t numChunks = (sizeInBytes + chunkSizeInBytes - 1) / chunkSizeInBytes;
+
+    // Each slot of the ring cycles through FREE -> SUBMITTED (calling thread) -> FREE (consumer) -> ...
+    // The consumer waits on the fence of a SUBMITTED slot itself before reading it. If the submission or the consume
+    // function fails, both threads stop and the error is rethrown once the copies in flight have finished.
+    enum class SlotState {
+        FREE, SUBMITTED
+    };
+    std::vector<SlotState> slotStates(numStagingChunks, SlotState::FREE);
+    std::mutex mutex;
+    std::condition_variable conditionVariable;
+    // Set if either thread fails, so the other one stops waiting for slots that will never change their state.
+    bool isAborted = false;
+    std::exception_ptr consumerException;
+    auto abortDownload = [&]() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            isAborted = true;
+        }
+        conditionVariable.notify_all();
+    };
+
+    auto startTime = std::chrono::steady_clock::now();
+    std::thread consumerThread([&]() {
+        try {
+            for (size_t chunkIdx = 0; chunkIdx < numChunks; chunkIdx++) {
+                size_t slotIdx = chunkIdx % numStagingChunks;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    conditionVariable.wait(lock, [&] {
+                        return isAborted || slotStates[slotIdx] == SlotState::SUBMITTED;
+                    });
+                    if (isAborted) {
+                        return;
+                    }
+                }
+                fences[slotIdx]->wait();
+                if (!isHostCoherent) {
+                    VkMappedMemoryRange mappedMemoryRange{};
+                    mappedMemoryRange.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+                    mappedMemoryRange.memory = stagingMemory[slotIdx];
+                    mappedMemoryRange.offset = 0;
+                    mappedMemoryRange.size = VK_WHOLE_SIZE;
+                    vkInvalidateMappedMemoryRanges(device->getVkDevice(), 1, &mappedMemoryRange);
+                }
+                size_t byteOffset = chunkIdx * chunkSizeInBytes;
+                auto consumeStartTime = std::chrono::steady_clock::now();
+                consumeChunk(
+                        stagingBuffersMapped[slotIdx], byteOffset,
+                        std::min(chunkSizeInBytes, sizeInBytes - byteOffset));
+                downloadStatistics.consumeSeconds += getSecondsSince(consumeStartTime);
+                // Reset only now, so stopConsumer does not wait on an unsignaled fence if consumeChunk throws.
+                fences[slotIdx]->reset();
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    slotStates[slotIdx] = SlotState::FREE;
+                }
+                conditionVariable.notify_all();
+            }
+        } catch (...) {
+            consumerException = std::current_exception();
+            abortDownload();
+        }
+    });
+    // Joins the consumer and waits for the copies still in flight, so the staging chunks can be reused or freed.
+    auto stopConsumer = [&]() {
+        abortDownload();
+        if (consumerThread.joinable()) {
+            consumerThread.join();
+        }
+        for (uint32_t slotIdx = 0; slotIdx < numStagingChunks; slotIdx++) {
+            if (slotStates[slotIdx] == SlotState::SUBMITTED) {
+                fences[slotIdx]->wait();
+                fences[slotIdx]->reset();
+                slotStates[slotIdx] = SlotState::FREE;
+            }
+        }
+    };
+
+    // The calling thread is the only one that records and submits, so the queue needs no further synchronization.
+    for (size_t chunkIdx = 0; chunkIdx < numChunks; chunkIdx++) {
+        size_t slotIdx = chunkIdx % numStagingChunks;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            conditionVariable.wait(lock, [&] { return isAborted || slotStates[slotIdx] == SlotState::FREE; });
+            if (isAborted) {
+                break;
+            }
+        }
+
+        VkCommandBuffer commandBuffer = commandBuffers[slotIdx];
+        VkCommandBufferBeginInfo beginInfo{};
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        vkBeginCommandBuffer(commandBuffer, &beginInfo);
+        if (chunkIdx == 0) {
+            // Covers the copies of all later submissions to this queue, too.
+            VkBufferMemoryBarrier bufferMemoryBarrier{};
+            bufferMemoryBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+            bufferMemoryBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+            bufferMemoryBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+            bufferMemoryBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            bufferMemoryBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            bufferMemoryBarrier.buffer = srcBuffer->getVkBuffer();
+            bufferMemoryBarrier.offset = 0;
+            bufferMemoryBarrier.size = VK_WHOLE_SIZE;
+            vkCmdPipelineBarrier(
+                    commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
+                    VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 1, &bufferMemoryBarrier, 0, nullptr);
+        }
+        VkBufferCopy bufferCopy{};
+        bufferCopy.srcOffset = chunkIdx * chunkSizeInBytes;
+        bufferCopy.dstOffset = 0;
+        bufferCopy.size = std::min(chunkSizeInBytes, sizeInBytes - bufferCopy.srcOffset);
+        vkCmdCopyBuffer(
+                commandBuffer, srcBuffer->getVkBuffer(), stagingBuffers[slotIdx]->getVkBuffer(), 1, &bufferCopy);
+        // The fence signal alone does not make the transfer writes available to the host.
+        VkBufferMemoryBarrier bufferMemoryBarrier{};
+        bufferMemoryBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+        bufferMemoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        bufferMemoryBarrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+        bufferMemoryBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        bufferMemoryBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        bufferMemoryBarrier.buffer = stagingBuffers[slotIdx]->getVkBuffer();
+        bufferMemoryBarrier.offset = 0;
+        bufferMemoryBarrier.size = VK_WHOLE_SIZE;
+        vkCmdPipelineBarrier(
+                commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0,
+                0, nullptr, 1, &bufferMemoryBarrier, 0, nullptr);
+        vkEndCommandBuffer(commandBuffer);
+
+        VkSubmitInfo submitInfo{};
+        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.commandBufferCount = 1;
+        submitInfo.pCommandBuffers = &commandBuffer;
+        if (vkQueueSubmit(device->getComputeQueue(), 1, &submitInfo, fences[slotIdx]->getVkFence()) != VK_SUCCESS) {
+            // The consumer may be blocked waiting for this slot, so it needs to be stopped before it can be joined.
+            stopConsumer();
+            sgl::Logfile::get()->throwError("Error in StreamingDownloader::download: vkQueueSubmit failed.");
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            slotStates[slotIdx] = SlotState::SUBMITTED;
+        }
+        conditionVariable.notify_all();
+    }
+
+    consumerThread.join();
+    if (consumerException) {
+        stopConsumer();
+        std::rethrow_exception(consumerException);
+    }
+    auto endTime = std::chrono::steady_clock::now();
+    downloadStatistics.timeSeconds = std::chrono::duration<double>(endTime - startTime).count();
+    return downloadStatistics;
+}
+
+void printDownloadStatistics(std::ostream& out, const DownloadStatistics& downloadStatistics) {
+    out
+            << "Streaming download: " << sgl::getNiceMemoryString(downloadStatistics.sizeInBytes, 2)
+            << " in " << (downloadStatistics.timeSeconds * 1e3) << "ms (" << downloadStatistics.getBandwidthGBs()
+            << " GB/s, " << downloadStatistics.numStagingChunks << " x "
+            << sgl::getNiceMemoryString(downloadStatistics.chunkSizeInBytes, 2) << " staging chunks)" << std::endl;
+}
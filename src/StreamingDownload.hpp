@@ -0,0 +1,97 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef BUFFERTEST64_STREAMINGDOWNLOAD_HPP
+#define BUFFERTEST64_STREAMINGDOWNLOAD_HPP
+
+#include <functional>
+#include <ostream>
+#include <vector>
+
+#include <Graphics/Vulkan/Buffers/Buffer.hpp>
+#include <Graphics/Vulkan/Utils/SyncObjects.hpp>
+
+struct DownloadStatistics {
+    size_t sizeInBytes = 0;
+    double timeSeconds = 0.0;
+    // Time spent in the consume function on the consumer thread.
+    double consumeSeconds = 0.0;
+    size_t chunkSizeInBytes = 0;
+    uint32_t numStagingChunks = 0;
+    [[nodiscard]] double getBandwidthGBs() const;
+};
+
+/**
+ * Downloads a device-local buffer through a fixed ring of staging chunks in a selectable host-visible memory type.
+ * The calling thread copies the next chunks with vkCmdCopyBuffer while a consumer thread processes the chunks whose
+ * copies have finished, so peak host memory usage is numStagingChunks * chunkSizeInBytes independent of the size of
+ * the source buffer. Non-coherent memory is invalidated before each chunk is consumed.
+ */
+class StreamingDownloader {
+public:
+    /**
+     * Processes the bytes [byteOffset, byteOffset + byteSize) of the source buffer stored in the staging memory 'src'.
+     * Called from the consumer thread.
+     */
+    using ConsumeChunkFunction = std::function<void(const void* src, size_t byteOffset, size_t byteSize)>;
+
+    /**
+     * Submits the copies to the compute queue. The memory type needs to be host visible, and chunkSizeInBytes and
+     * numStagingChunks need to be non-zero.
+     */
+    StreamingDownloader(
+            sgl::vk::Device* device, size_t chunkSizeInBytes, uint32_t numStagingChunks, uint32_t memoryTypeIndex);
+    ~StreamingDownloader();
+    StreamingDownloader(const StreamingDownloader&) = delete;
+    StreamingDownloader& operator=(const StreamingDownloader&) = delete;
+
+    /**
+     * The source buffer needs VK_BUFFER_USAGE_TRANSFER_SRC_BIT. Previous compute shader and transfer writes to it on
+     * the compute queue are made visible to the copies.
+     */
+    DownloadStatistics download(const sgl::vk::BufferPtr& srcBuffer, const ConsumeChunkFunction& consumeChunk);
+
+private:
+    void createStagingChunks(uint32_t memoryTypeIndex);
+    /// Frees the staging chunks created so far; used by the destructor and if the constructor fails.
+    void release();
+
+    sgl::vk::Device* device;
+    size_t chunkSizeInBytes;
+    uint32_t numStagingChunks;
+    bool isHostCoherent;
+    std::vector<VkDeviceMemory> stagingMemory;
+    std::vector<sgl::vk::BufferPtr> stagingBuffers;
+    std::vector<void*> stagingBuffersMapped;
+    std::vector<sgl::vk::FencePtr> fences;
+    VkCommandPool commandPool{};
+    std::vector<VkCommandBuffer> commandBuffers;
+};
+
+void printDownloadStatistics(std::ostream& out, const DownloadStatistics& downloadStatistics);
+
+#endif //BUFFERTEST64_STREAMINGDOWNLOAD_HPP
@@ -0,0 +1,285 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <thread>
+#include <exception>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+
+#include <Utils/File/Logfile.hpp>
+#include <Graphics/Vulkan/Utils/Device.hpp>
+#include <ImGui/Widgets/NumberFormatting.hpp>
+
+#include "Timing.hpp"
+#include "StreamingUpload.hpp"
+
+double UploadStatistics::getBandwidthGBs() const {
+    if (timeSeconds <= 0.0) {
+        return 0.0;
+    }
+    return double(sizeInBytes) / timeSeconds * 1e-9;
+}
+
+StreamingUploader::StreamingUploader(sgl::vk::Device* device, size_t chunkSizeInBytes, uint32_t numStagingChunks)
+        : StreamingUploader(
+                device, chunkSizeInBytes, numStagingChunks, device->getComputeQueueIndex(), device->getComputeQueue()) {
+}
+
+StreamingUploader::StreamingUploader(
+        sgl::vk::Device* device, size_t chunkSizeInBytes, uint32_t numStagingChunks,
+        uint32_t queueFamilyIndex, VkQueue queue)
+        : device(device), queueFamilyIndex(queueFamilyIndex), queue(queue),
+          chunkSizeInBytes(chunkSizeInBytes), numStagingChunks(numStagingChunks) {
+    if (chunkSizeInBytes == 0 || numStagingChunks == 0) {
+        sgl::Logfile::get()->throwError(
+                "Error in StreamingUploader::StreamingUploader: The chunk size and number of chunks must be non-zero.");
+    }
+    sgl::vk::CommandPoolType commandPoolType{};
+    commandPoolType.queueFamilyIndex = queueFamilyIndex;
+    commandPoolType.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+    for (uint32_t i = 0; i < numStagingChunks; i++) {
+        auto stagingBuffer = std::make_shared<sgl::vk::Buffer>(
+                device, chunkSizeInBytes, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_MEMORY_USAGE_CPU_ONLY);
+        stagingBuffersMapped.push_back(stagingBuffer->mapMemory());
+        stagingBuffers.push_back(stagingBuffer);
+        fences.push_back(std::make_shared<sgl::vk::Fence>(device));
+        commandBuffers.push_back(device->allocateCommandBuffer(commandPoolType, &commandPool));
+    }
+}
+
+StreamingUploader::~StreamingUploader() {
+    for (auto& stagingBuffer : stagingBuffers) {
+        stagingBuffer->unmapMemory();
+    }
+    for (VkCommandBuffer commandBuffer : commandBuffers) {
+        device->freeCommandBuffer(commandPool, commandBuffer);
+    }
+}
+
+UploadStatistics StreamingUploader::upload(
+        const sgl::vk::BufferPtr& dstBuffer, const FillChunkFunction& fillChunk, const UploadHandoff* handoff) {
+    UploadStatistics uploadStatistics{};
+    uploadStatistics.sizeInBytes = dstBuffer->getSizeInBytes();
+    uploadStatistics.chunkSizeInBytes = chunkSizeInBytes;
+    uploadStatistics.numStagingChunks = numStagingChunks;
+    const size_t sizeInBytes = dstBuffer->getSizeInBytes();
+    const size_t numChunks = (sizeInBytes + chunkSizeInBytes - 1) / chunkSizeInBytes;
+
+    // Each slot of the ring cycles through FREE -> FILLED (producer) -> SUBMITTED (consumer) -> FILLED -> ...
+    // The producer waits on the fence of a SUBMITTED slot itself before refilling it.
+    enum class SlotState {
+        FREE, FILLED, SUBMITTED
+    };
+    std::vector<SlotState> slotStates(numStagingChunks, SlotState::FREE);
+    std::mutex mutex;
+    std::condition_variable conditionVariable;
+    bool isAborted = false;
+    double fillSeconds = 0.0;
+    // An exception escaping the thread function would call std::terminate, so it is rethrown on the calling thread.
+    std::exception_ptr producerException;
+
+    auto startTime = std::chrono::steady_clock::now();
+    auto produceChunks = [&]() {
+        for (size_t chunkIdx = 0; chunkIdx < numChunks; chunkIdx++) {
+            size_t slotIdx = chunkIdx % numStagingChunks;
+            bool wasSubmitted;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                conditionVariable.wait(lock, [&] { return isAborted || slotStates[slotIdx] != SlotState::FILLED; });
+                if (isAborted) {
+                    return;
+                }
+                wasSubmitted = slotStates[slotIdx] == SlotState::SUBMITTED;
+            }
+            if (wasSubmitted) {
+                fences[slotIdx]->wait();
+                fences[slotIdx]->reset();
+            }
+            size_t byteOffset = chunkIdx * chunkSizeInBytes;
+            auto fillStartTime = std::chrono::steady_clock::now();
+            fillChunk(stagingBuffersMapped[slotIdx], byteOffset, std::min(chunkSizeInBytes, sizeInBytes - byteOffset));
+            fillSeconds += getSecondsSince(fillStartTime);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                slotStates[slotIdx] = SlotState::FILLED;
+            }
+            conditionVariable.notify_all();
+        }
+    };
+    std::thread producerThread([&]() {
+        try {
+            produceChunks();
+        } catch (...) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                producerException = std::current_exception();
+                isAborted = true;
+            }
+            conditionVariable.notify_all();
+        }
+    });
+
+    // The calling thread is the only one that records and submits, so the queue needs no further synchronization.
+    bool isSubmitFailed = false;
+    for (size_t chunkIdx = 0; chunkIdx < numChunks; chunkIdx++) {
+        size_t slotIdx = chunkIdx % numStagingChunks;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            conditionVariable.wait(lock, [&] { return isAborted || slotStates[slotIdx] == SlotState::FILLED; });
+            if (isAborted) {
+                break;
+            }
+        }
+
+        VkCommandBuffer commandBuffer = commandBuffers[slotIdx];
+        VkCommandBufferBeginInfo beginInfo{};
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        vkBeginCommandBuffer(commandBuffer, &beginInfo);
+        VkBufferCopy bufferCopy{};
+        bufferCopy.srcOffset = 0;
+        bufferCopy.dstOffset = chunkIdx * chunkSizeInBytes;
+        bufferCopy.size = std::min(chunkSizeInBytes, sizeInBytes - bufferCopy.dstOffset);
+        vkCmdCopyBuffer(
+                commandBuffer, stagingBuffers[slotIdx]->getVkBuffer(), dstBuffer->getVkBuffer(), 1, &bufferCopy);
+        bool isReleased = handoff && handoff->dstQueueFamilyIndex != queueFamilyIndex;
+        if (chunkIdx == numChunks - 1 && isReleased) {
+            // Release half of the queue family ownership transfer; covers all previous submissions to this queue, too.
+            VkBufferMemoryBarrier bufferMemoryBarrier{};
+            bufferMemoryBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+            bufferMemoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            bufferMemoryBarrier.dstAccessMask = 0;
+            bufferMemoryBarrier.srcQueueFamilyIndex = queueFamilyIndex;
+            bufferMemoryBarrier.dstQueueFamilyIndex = handoff->dstQueueFamilyIndex;
+            bufferMemoryBarrier.buffer = dstBuffer->getVkBuffer();
+            bufferMemoryBarrier.offset = 0;
+            bufferMemoryBarrier.size = VK_WHOLE_SIZE;
+            vkCmdPipelineBarrier(
+                    commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0,
+                    0, nullptr, 1, &bufferMemoryBarrier, 0, nullptr);
+        } else if (chunkIdx == numChunks - 1) {
+            // Covers the copies of all previous submissions to this queue, too.
+            VkBufferMemoryBarrier bufferMemoryBarrier{};
+            bufferMemoryBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+            bufferMemoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            bufferMemoryBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+            bufferMemoryBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            bufferMemoryBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            bufferMemoryBarrier.buffer = dstBuffer->getVkBuffer();
+            bufferMemoryBarrier.offset = 0;
+            bufferMemoryBarrier.size = VK_WHOLE_SIZE;
+            vkCmdPipelineBarrier(
+                    commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0,
+                    0, nullptr, 1, &bufferMemoryBarrier, 0, nullptr);
+        }
+        vkEndCommandBuffer(commandBuffer);
+
+        VkSubmitInfo submitInfo{};
+        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.commandBufferCount = 1;
+        submitInfo.pCommandBuffers = &commandBuffer;
+        VkSemaphore signalSemaphore = VK_NULL_HANDLE;
+        VkTimelineSemaphoreSubmitInfo timelineSubmitInfo{};
+        if (chunkIdx == numChunks - 1 && handoff) {
+            signalSemaphore = handoff->timelineSemaphore->getVkSemaphore();
+            timelineSubmitInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+            timelineSubmitInfo.signalSemaphoreValueCount = 1;
+            timelineSubmitInfo.pSignalSemaphoreValues = &handoff->signalValue;
+            submitInfo.pNext = &timelineSubmitInfo;
+            submitInfo.signalSemaphoreCount = 1;
+            submitInfo.pSignalSemaphores = &signalSemaphore;
+        }
+        if (vkQueueSubmit(queue, 1, &submitInfo, fences[slotIdx]->getVkFence()) != VK_SUCCESS) {
+            // The producer may be blocked on a FILLED slot, so it needs to be stopped before the thread can be joined.
+            isSubmitFailed = true;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                isAborted = true;
+            }
+            conditionVariable.notify_all();
+            break;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            slotStates[slotIdx] = SlotState::SUBMITTED;
+        }
+        conditionVariable.notify_all();
+    }
+
+    producerThread.join();
+    // Also done when aborting, as the staging buffers must not be reused or freed while earlier copies may still read
+    // from them.
+    for (uint32_t slotIdx = 0; slotIdx < numStagingChunks; slotIdx++) {
+        if (slotStates[slotIdx] == SlotState::SUBMITTED) {
+            fences[slotIdx]->wait();
+            fences[slotIdx]->reset();
+            slotStates[slotIdx] = SlotState::FREE;
+        }
+    }
+    if (producerException) {
+        std::rethrow_exception(producerException);
+    }
+    if (isSubmitFailed) {
+        sgl::Logfile::get()->throwError("Error in StreamingUploader::upload: vkQueueSubmit failed.");
+    }
+    auto endTime = std::chrono::steady_clock::now();
+    uploadStatistics.timeSeconds = std::chrono::duration<double>(endTime - startTime).count();
+    uploadStatistics.fillSeconds = fillSeconds;
+    return uploadStatistics;
+}
+
+void recordQueueFamilyAcquireBarrier(
+        VkCommandBuffer commandBuffer, const sgl::vk::BufferPtr& buffer,
+        uint32_t srcQueueFamilyIndex, uint32_t dstQueueFamilyIndex) {
+    if (srcQueueFamilyIndex == dstQueueFamilyIndex) {
+        return;
+    }
+    // The semaphore wait of the submission makes the transfer writes available, so the source access mask is empty.
+    VkBufferMemoryBarrier bufferMemoryBarrier{};
+    bufferMemoryBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    bufferMemoryBarrier.srcAccessMask = 0;
+    bufferMemoryBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    bufferMemoryBarrier.srcQueueFamilyIndex = srcQueueFamilyIndex;
+    bufferMemoryBarrier.dstQueueFamilyIndex = dstQueueFamilyIndex;
+    bufferMemoryBarrier.buffer = buffer->getVkBuffer();
+    bufferMemoryBarrier.offset = 0;
+    bufferMemoryBarrier.size = VK_WHOLE_SIZE;
+    vkCmdPipelineBarrier(
+            commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0,
+            0, nullptr, 1, &bufferMemoryBarrier, 0, nullptr);
+}
+
+void printUploadStatistics(std::ostream& out, const UploadStatistics& uploadStatistics) {
+    out
+            << "Streaming upload: " << sgl::getNiceMemoryString(uploadStatistics.sizeInBytes, 2)
+            << " in " << (uploadStatistics.timeSeconds * 1e3) << "ms (" << uploadStatistics.getBandwidthGBs()
+            << " GB/s, " << uploadStatistics.numStagingChunks << " x "
+            << sgl::getNiceMemoryString(uploadStatistics.chunkSizeInBytes, 2) << " staging chunks, including "
+            << (uploadStatistics.fillSeconds * 1e3) << "ms of overlapped fill)" << std::endl;
+}
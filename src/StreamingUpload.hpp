@@ -0,0 +1,111 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef BUFFERTEST64_STREAMINGUPLOAD_HPP
+#define BUFFERTEST64_STREAMINGUPLOAD_HPP
+
+#include <functional>
+#include <ostream>
+#include <vector>
+
+#include <Graphics/Vulkan/Buffers/Buffer.hpp>
+#include <Graphics/Vulkan/Utils/SyncObjects.hpp>
+
+struct UploadStatistics {
+    size_t sizeInBytes = 0;
+    /// Wall time of the whole upload, which includes filling the staging chunks on the producer thread.
+    double timeSeconds = 0.0;
+    /// Time the producer thread spent in the fill function; overlaps with the copies of previously filled chunks.
+    double fillSeconds = 0.0;
+    size_t chunkSizeInBytes = 0;
+    uint32_t numStagingChunks = 0;
+    [[nodiscard]] double getBandwidthGBs() const;
+};
+
+/**
+ * Hands the destination buffer of an upload over to another queue. The last copy signals signalValue on the timeline
+ * semaphore and, if dstQueueFamilyIndex differs from the queue family of the uploader, releases the buffer to that
+ * family. The receiving queue needs to wait on the semaphore and record the matching acquire barrier with
+ * recordQueueFamilyAcquireBarrier.
+ */
+struct UploadHandoff {
+    sgl::vk::SemaphorePtr timelineSemaphore;
+    uint64_t signalValue = 0;
+    uint32_t dstQueueFamilyIndex = 0;
+};
+
+/**
+ * Uploads data to a device-local buffer through a fixed ring of host-visible staging chunks. A producer thread fills
+ * the next free chunk while the previously filled chunks are copied with vkCmdCopyBuffer, so peak host memory usage is
+ * numStagingChunks * chunkSizeInBytes independent of the size of the destination buffer.
+ */
+class StreamingUploader {
+public:
+    /**
+     * Fills the staging memory 'dst' with the bytes [byteOffset, byteOffset + byteSize) of the destination buffer.
+     * Called from the producer thread; exceptions it throws are rethrown by upload once all copies have finished.
+     */
+    using FillChunkFunction = std::function<void(void* dst, size_t byteOffset, size_t byteSize)>;
+
+    /// Submits the copies to the compute queue. chunkSizeInBytes and numStagingChunks need to be non-zero.
+    StreamingUploader(sgl::vk::Device* device, size_t chunkSizeInBytes, uint32_t numStagingChunks);
+    /// Submits the copies to a queue of the passed family, e.g., a queue other than the compute queue.
+    StreamingUploader(
+            sgl::vk::Device* device, size_t chunkSizeInBytes, uint32_t numStagingChunks,
+            uint32_t queueFamilyIndex, VkQueue queue);
+    ~StreamingUploader();
+
+    /**
+     * The destination buffer needs VK_BUFFER_USAGE_TRANSFER_DST_BIT. Without a handoff, it is ready for compute shader
+     * reads on the queue of the uploader afterwards.
+     */
+    UploadStatistics upload(
+            const sgl::vk::BufferPtr& dstBuffer, const FillChunkFunction& fillChunk,
+            const UploadHandoff* handoff = nullptr);
+
+private:
+    sgl::vk::Device* device;
+    uint32_t queueFamilyIndex;
+    VkQueue queue;
+    size_t chunkSizeInBytes;
+    uint32_t numStagingChunks;
+    std::vector<sgl::vk::BufferPtr> stagingBuffers;
+    std::vector<void*> stagingBuffersMapped;
+    std::vector<sgl::vk::FencePtr> fences;
+    VkCommandPool commandPool{};
+    std::vector<VkCommandBuffer> commandBuffers;
+};
+
+/// Acquires a buffer released by an upload with a handoff from srcQueueFamilyIndex; no-op for the same family.
+void recordQueueFamilyAcquireBarrier(
+        VkCommandBuffer commandBuffer, const sgl::vk::BufferPtr& buffer,
+        uint32_t srcQueueFamilyIndex, uint32_t dstQueueFamilyIndex);
+
+void printUploadStatistics(std::ostream& out, const UploadStatistics& uploadStatistics);
+
+#endif //BUFFERTEST64_STREAMINGUPLOAD_HPP
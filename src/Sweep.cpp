@@ -0,0 +1,358 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+
+#include <Utils/File/Logfile.hpp>
+#include <Graphics/Vulkan/Buffers/Buffer.hpp>
+#include <Graphics/Vulkan/Render/Renderer.hpp>
+#include <ImGui/Widgets/NumberFormatting.hpp>
+
+#include "FieldsBuffers.hpp"
+#include "BufferTestComputePass.hpp"
+#include "ComputeQueueSubmitter.hpp"
+#include "ResultsWriter.hpp"
+#include "Sweep.hpp"
+
+// Probe sizes are multiples of one slice of 512x512x16 entries, i.e., 16MiB for float and 4MiB for uint8_t data.
+static const uint32_t SWEEP_XS = 512;
+static const uint32_t SWEEP_YS = 512;
+static const uint32_t SWEEP_ZS = 16;
+static const size_t SWEEP_SLICE_ENTRIES = size_t(SWEEP_XS) * size_t(SWEEP_YS) * size_t(SWEEP_ZS);
+
+struct SweepResult {
+    TestDataType testDataType;
+    bool useHostAllocation;
+    TestMode testMode;
+    size_t largestAllocationSizeInBytes;
+    size_t largestPassingSizeInBytes;
+    uint32_t numProbes;
+};
+
+/**
+ * Searches the largest passing number of slices in [1, maxNumSlices]. The sizes are walked geometrically until the
+ * first failure and then bisected. The search assumes that all sizes below the first failing one pass, i.e., that
+ * there is a single limit. The probes are passed back by the caller, so multiple searches can share one probe.
+ */
+class SliceSearch {
+public:
+    explicit SliceSearch(uint32_t maxNumSlices)
+            : maxNumSlices(maxNumSlices), firstFailing(uint64_t(maxNumSlices) + 1) {}
+    [[nodiscard]] inline bool getIsDone() const { return firstFailing - lastPassing <= 1; }
+    [[nodiscard]] uint32_t getNextNumSlices() const {
+        if (isWalkingGeometrically) {
+            return lastPassing == 0 ? 1 : uint32_t(std::min(uint64_t(lastPassing) * 2, uint64_t(maxNumSlices)));
+        }
+        return uint32_t(lastPassing + (firstFailing - lastPassing) / 2);
+    }
+    void addProbe(uint32_t numSlices, bool passed) {
+        numProbes++;
+        if (passed) {
+            lastPassing = numSlices;
+        } else {
+            firstFailing = numSlices;
+            isWalkingGeometrically = false;
+        }
+    }
+    /// Returns 0 if even a single slice fails.
+    [[nodiscard]] inline uint32_t getLargestPassingNumSlices() const { return lastPassing; }
+    [[nodiscard]] inline uint32_t getNumProbes() const { return numProbes; }
+
+private:
+    uint32_t maxNumSlices;
+    uint32_t lastPassing = 0;
+    uint64_t firstFailing;
+    bool isWalkingGeometrically = true;
+    uint32_t numProbes = 0;
+};
+
+/**
+ * Checks whether the last entry of a fields buffer can be read correctly. Each probe gets its own fields buffer of
+ * exactly the probe size, so the storage buffer descriptors only cover the probed range and the storage buffer range
+ * limit can be told apart from the allocation limit.
+ */
+class SizeProber {
+public:
+    SizeProber(sgl::vk::Device* device, TestDataType testDataType);
+    /// Returns the value of the last entry read by the pass, which is 42 if the probe passes.
+    float probe(BufferTestComputePass* pass, const sgl::vk::BufferPtr& fieldsBuffer, uint32_t numSlices);
+
+    [[nodiscard]] inline sgl::vk::Renderer* getRenderer() { return submitter.getRenderer(); }
+    [[nodiscard]] inline const sgl::vk::BufferPtr& getOutputBuffer() { return outputBuffer; }
+
+private:
+    TestDataType testDataType;
+    ComputeQueueSubmitter submitter;
+    sgl::vk::BufferPtr outputBuffer, outputStagingBuffer;
+};
+
+SizeProber::SizeProber(sgl::vk::Device* device, TestDataType testDataType)
+        : testDataType(testDataType), submitter(device) {
+    outputBuffer = std::make_shared<sgl::vk::Buffer>(
+            device, MAX_TEST_DATA_TYPE_SIZE,
+            VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+            VMA_MEMORY_USAGE_GPU_ONLY);
+    outputStagingBuffer = std::make_shared<sgl::vk::Buffer>(
+            device, MAX_TEST_DATA_TYPE_SIZE, VK_BUFFER_USAGE_TRANSFER_DST_BIT, VMA_MEMORY_USAGE_GPU_TO_CPU);
+}
+
+float SizeProber::probe(BufferTestComputePass* pass, const sgl::vk::BufferPtr& fieldsBuffer, uint32_t numSlices) {
+    sgl::vk::Renderer* renderer = submitter.getRenderer();
+    VkCommandBuffer commandBuffer = submitter.getVkCommandBuffer();
+    submitter.begin();
+    outputBuffer->fill(0, commandBuffer);
+    renderer->insertBufferMemoryBarrier(
+            VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_WRITE_BIT,
+            VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            outputBuffer);
+    pass->setDimensions(SWEEP_XS, SWEEP_YS, SWEEP_ZS, numSlices);
+    pass->setFieldsBuffer(fieldsBuffer);
+    pass->render();
+    renderer->insertBufferMemoryBarrier(
+            VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+            outputBuffer);
+    outputBuffer->copyDataTo(outputStagingBuffer, commandBuffer);
+    submitter.submitAndWait();
+    // Does not keep the fields buffer alive until the next probe of the pass, which may use another size.
+    pass->setFieldsBuffer({});
+
+    auto* outputData = static_cast<uint8_t*>(outputStagingBuffer->mapMemory());
+    float outputValue = readDataTypeValue(testDataType, outputData);
+    outputStagingBuffer->unmapMemory();
+    return outputValue;
+}
+
+static size_t getLargestDeviceLocalHeapSize(sgl::vk::Device* device) {
+    const VkPhysicalDeviceMemoryProperties& deviceMemoryProperties = device->getMemoryProperties();
+    VkDeviceSize largestHeapSize = 0;
+    for (uint32_t heapIdx = 0; heapIdx < deviceMemoryProperties.memoryHeapCount; heapIdx++) {
+        if ((deviceMemoryProperties.memoryHeaps[heapIdx].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0) {
+            largestHeapSize = std::max(largestHeapSize, deviceMemoryProperties.memoryHeaps[heapIdx].size);
+        }
+    }
+    return size_t(largestHeapSize);
+}
+
+/// Bisects the largest number of slices that can be allocated at once. The probes are not filled.
+static uint32_t searchLargestAllocationNumSlices(
+        const TestSettings& testSettings, const TestContext& ctx, size_t sliceSizeInBytes, uint32_t maxNumSlices,
+        bool useHostAllocation, uint32_t& numProbes) {
+    SliceSearch search(maxNumSlices);
+    while (!search.getIsDone()) {
+        uint32_t numSlices = search.getNextNumSlices();
+        bool passed = true;
+        try {
+            allocateFieldsBuffer(testSettings, ctx, size_t(numSlices) * sliceSizeInBytes, useHostAllocation);
+        } catch (const std::exception&) {
+            passed = false;
+        }
+        search.addProbe(numSlices, passed);
+    }
+    numProbes = search.getNumProbes();
+    return search.getLargestPassingNumSlices();
+}
+
+static void sweepDataType(
+        const TestSettings& testSettings, const TestContext& ctx, TestDataType testDataType, bool useHostAllocation,
+        std::vector<SweepResult>& results) {
+    sgl::vk::Device* device = ctx.device;
+    ctx.out << std::endl;
+    ctx.out << "Sweeping type " << TEST_DATA_TYPE_NAMES[int(testDataType)];
+    if (useHostAllocation) {
+        ctx.out << ", host allocation" << std::endl;
+    } else {
+        ctx.out << ", device allocation" << std::endl;
+    }
+
+    const size_t dataTypeSize = getTestDataTypeSize(testDataType);
+    const size_t sliceSizeInBytes = SWEEP_SLICE_ENTRIES * dataTypeSize;
+    size_t maxSizeInBytes = testSettings.sweepMaxSizeInBytes;
+    if (!useHostAllocation) {
+        maxSizeInBytes = std::min(maxSizeInBytes, getLargestDeviceLocalHeapSize(device));
+    }
+    const auto maxNumSlices = uint32_t(std::min(maxSizeInBytes / sliceSizeInBytes, size_t(UINT32_MAX)));
+    if (maxNumSlices == 0) {
+        sgl::Logfile::get()->writeError("Error in sweepDataType: The maximum size is smaller than a single slice.");
+        return;
+    }
+    uint32_t numAllocationProbes = 0;
+    const uint32_t allocationNumSlices = searchLargestAllocationNumSlices(
+            testSettings, ctx, sliceSizeInBytes, maxNumSlices, useHostAllocation, numAllocationProbes);
+    const size_t largestAllocationSizeInBytes = size_t(allocationNumSlices) * sliceSizeInBytes;
+    ctx.out
+            << "Largest allocation: " << sgl::getNiceMemoryString(largestAllocationSizeInBytes, 2)
+            << " (" << numAllocationProbes << " probes)" << std::endl;
+    if (allocationNumSlices == 0) {
+        sgl::Logfile::get()->writeError("Error in sweepDataType: Could not allocate a single slice.");
+        return;
+    }
+
+    SizeProber prober(device, testDataType);
+    std::vector<TestMode> testModes;
+    std::vector<std::shared_ptr<BufferTestComputePass>> passes;
+    std::vector<SliceSearch> searches;
+    for (int i = 0; i < NUM_TESTS; i++) {
+        // The members of the buffer array are separate allocations of one slice each, so there is no limit to find.
+        if (TEST_MODE_USES_ARRAY[i] || !testSettings.testPlan.getIsTestModeSelected(TestMode(i))) {
+            continue;
+        }
+        if (!device->getShader64BitIndexingFeaturesEXT().shader64BitIndexing && i >= int(TestMode::STORAGE_BUFFER_64_BIT)) {
+            break;
+        }
+        auto pass = std::make_shared<BufferTestComputePass>(
+                prober.getRenderer(), ctx.shaderCache, SWEEP_XS, SWEEP_YS, SWEEP_ZS, allocationNumSlices);
+        pass->setTestMode(TestMode(i));
+        pass->setDataType(testDataType);
+        pass->setOutputBuffer(prober.getOutputBuffer(), 0);
+        testModes.push_back(TestMode(i));
+        passes.push_back(pass);
+        searches.emplace_back(allocationNumSlices);
+    }
+
+    // The searches of all test modes run in lockstep, and the modes probing the same size share one fields buffer. As
+    // all searches start with the same geometric walk, most buffers are only allocated and filled once.
+    while (true) {
+        uint32_t numSlices = UINT32_MAX;
+        for (const SliceSearch& search : searches) {
+            if (!search.getIsDone()) {
+                numSlices = std::min(numSlices, search.getNextNumSlices());
+            }
+        }
+        if (numSlices == UINT32_MAX) {
+            break;
+        }
+
+        const size_t sizeInBytes = size_t(numSlices) * sliceSizeInBytes;
+        FieldsBufferTimings timings{};
+        sgl::vk::BufferPtr fieldsBuffer;
+        try {
+            fieldsBuffer = createFieldsBuffer(
+                    testSettings, ctx, testDataType, sizeInBytes / dataTypeSize, sizeInBytes, useHostAllocation,
+                    nullptr, &timings);
+        } catch (const std::exception& e) {
+            ctx.out << "Allocation failed: " << e.what() << std::endl;
+        }
+        for (size_t modeIdx = 0; modeIdx < searches.size(); modeIdx++) {
+            SliceSearch& search = searches.at(modeIdx);
+            if (search.getIsDone() || search.getNextNumSlices() != numSlices) {
+                continue;
+            }
+            // An allocation below the largest one may still fail, e.g., due to fragmentation; this can't be probed.
+            if (!fieldsBuffer) {
+                search.addProbe(numSlices, false);
+                continue;
+            }
+            float outputValue = prober.probe(passes.at(modeIdx).get(), fieldsBuffer, numSlices);
+            search.addProbe(numSlices, outputValue == 42);
+            if (ctx.resultsWriter) {
+                TestRecord record{};
+                record.testMode = testModes.at(modeIdx);
+                record.testDataType = testDataType;
+                record.useHostAllocation = useHostAllocation;
+                record.sizeInBytes = sizeInBytes;
+                record.passed = outputValue == 42;
+                record.value = double(outputValue);
+                record.allocationSeconds = timings.allocationSeconds;
+                record.fillSeconds = timings.fillSeconds;
+                record.uploadSeconds = timings.uploadSeconds;
+                ctx.resultsWriter->writeRecord(device, record);
+            }
+        }
+    }
+
+    for (size_t modeIdx = 0; modeIdx < searches.size(); modeIdx++) {
+        SweepResult result{};
+        result.testDataType = testDataType;
+        result.useHostAllocation = useHostAllocation;
+        result.testMode = testModes.at(modeIdx);
+        result.largestAllocationSizeInBytes = largestAllocationSizeInBytes;
+        result.largestPassingSizeInBytes = size_t(searches.at(modeIdx).getLargestPassingNumSlices()) * sliceSizeInBytes;
+        result.numProbes = searches.at(modeIdx).getNumProbes();
+        ctx.out
+                << "Test case '" << TEST_MODE_NAMES[int(result.testMode)] << "': largest passing size "
+                << sgl::getNiceMemoryString(result.largestPassingSizeInBytes, 2)
+                << " (" << result.numProbes << " probes)" << std::endl;
+        results.push_back(result);
+    }
+}
+
+static void printLimitsTable(const TestContext& ctx, const std::vector<SweepResult>& results) {
+    sgl::vk::Device* device = ctx.device;
+    ctx.out << std::endl << "Limits of device '" << device->getDeviceName() << "':" << std::endl;
+    ctx.out
+            << "Max storage buffer range: "
+            << sgl::getNiceMemoryString(device->getLimits().maxStorageBufferRange, 2) << std::endl;
+    ctx.out
+            << "Max memory allocation size: "
+            << sgl::getNiceMemoryString(device->getPhysicalDeviceVulkan11Properties().maxMemoryAllocationSize, 2)
+            << std::endl;
+    ctx.out
+            << "Largest device local heap: "
+            << sgl::getNiceMemoryString(getLargestDeviceLocalHeapSize(device), 2) << std::endl;
+
+    ctx.out
+            << std::left << std::setw(8) << "Type" << std::setw(12) << "Allocation"
+            << std::setw(40) << "Test mode" << std::setw(20) << "Largest passing"
+            << std::setw(20) << "Largest allocation" << "Probes" << std::endl;
+    for (const SweepResult& result : results) {
+        ctx.out
+                << std::left << std::setw(8) << TEST_DATA_TYPE_NAMES[int(result.testDataType)]
+                << std::setw(12) << (result.useHostAllocation ? "host" : "device")
+                << std::setw(40) << TEST_MODE_NAMES[int(result.testMode)]
+                << std::setw(20) << sgl::getNiceMemoryString(result.largestPassingSizeInBytes, 2)
+                << std::setw(20) << sgl::getNiceMemoryString(result.largestAllocationSizeInBytes, 2)
+                << result.numProbes << std::endl;
+    }
+    ctx.out << std::right;
+}
+
+void runSweep(const TestSettings& testSettings, const TestContext& ctx) {
+    sgl::vk::Device* device = ctx.device;
+    const TestPlan& testPlan = testSettings.testPlan;
+    std::vector<SweepResult> results;
+    // The same data type and allocation kind filters as for the fixed-size tests.
+    for (int testDataTypeIdx = 0; testDataTypeIdx < NUM_TEST_DATA_TYPES; testDataTypeIdx++) {
+        auto testDataType = TestDataType(testDataTypeIdx);
+        if (!testPlan.getIsDataTypeSelected(testDataType) || !getIsTestDataTypeSupported(device, testDataType)) {
+            continue;
+        }
+        for (int useHostAllocation = 0; useHostAllocation <= 1; useHostAllocation++) {
+            if (testDataType == TestDataType::UINT8 && useHostAllocation) {
+                continue;
+            }
+            if (useHostAllocation ? !testPlan.useHostAllocation : !testPlan.useDeviceAllocation) {
+                continue;
+            }
+            sweepDataType(testSettings, ctx, testDataType, bool(useHostAllocation), results);
+        }
+    }
+    printLimitsTable(ctx, results);
+}
@@ -0,0 +1,235 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <limits>
+
+#include <Utils/File/Logfile.hpp>
+#include <Utils/Json/SimpleJson.hpp>
+
+#include "TestPlan.hpp"
+
+bool TestPlan::getIsDeviceSelected(size_t deviceIdx) const {
+    return deviceIndices.empty()
+            || std::find(deviceIndices.begin(), deviceIndices.end(), uint32_t(deviceIdx)) != deviceIndices.end();
+}
+
+bool TestPlan::getIsTestModeSelected(TestMode testMode) const {
+    return testModes.empty() || std::find(testModes.begin(), testModes.end(), testMode) != testModes.end();
+}
+
+bool TestPlan::getIsDataTypeSelected(TestDataType dataType) const {
+    return dataTypes.empty() || std::find(dataTypes.begin(), dataTypes.end(), dataType) != dataTypes.end();
+}
+
+static std::vector<std::string> splitList(const std::string& str, char separator) {
+    std::vector<std::string> items;
+    std::string item;
+    std::istringstream stream(str);
+    while (std::getline(stream, item, separator)) {
+        if (!item.empty()) {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+uint32_t parseUint32(const std::string& str) {
+    // std::stoul would accept signs, whitespace and trailing characters, and wrap values above 2^32 - 1.
+    if (str.empty() || str.size() > 10 || str.find_first_not_of("0123456789") != std::string::npos
+            || std::stoull(str) > uint64_t(std::numeric_limits<uint32_t>::max())) {
+        sgl::Logfile::get()->throwError("Error in parseUint32: Invalid number \"" + str + "\".");
+    }
+    return uint32_t(std::stoull(str));
+}
+
+static TestMode parseTestMode(const std::string& str) {
+    for (int i = 0; i < NUM_TESTS; i++) {
+        if (str == TEST_MODE_IDS[i]) {
+            return TestMode(i);
+        }
+    }
+    sgl::Logfile::get()->throwError("Error in parseTestMode: Unknown test mode \"" + str + "\".");
+    return TestMode::STORAGE_BUFFER;
+}
+
+static TestDataType parseDataType(const std::string& str) {
+    for (int i = 0; i < NUM_TEST_DATA_TYPES; i++) {
+        if (str == TEST_DATA_TYPE_IDS[i] || str == TEST_DATA_TYPE_NAMES[i]) {
+            return TestDataType(i);
+        }
+    }
+    sgl::Logfile::get()->throwError("Error in parseDataType: Unknown data type \"" + str + "\".");
+    return TestDataType::FLOAT;
+}
+
+uint32_t parseRepetitions(const std::string& str) {
+    uint32_t numRepetitions = parseUint32(str);
+    if (numRepetitions == 0) {
+        sgl::Logfile::get()->throwError("Error in parseRepetitions: The number of repetitions must be at least 1.");
+    }
+    return numRepetitions;
+}
+
+std::vector<uint32_t> parseDeviceIndexList(const std::string& str) {
+    std::vector<uint32_t> deviceIndices;
+    for (const std::string& item : splitList(str, ',')) {
+        deviceIndices.push_back(parseUint32(item));
+    }
+    return deviceIndices;
+}
+
+std::vector<TestMode> parseTestModeList(const std::string& str) {
+    std::vector<TestMode> testModes;
+    for (const std::string& item : splitList(str, ',')) {
+        testModes.push_back(parseTestMode(item));
+    }
+    return testModes;
+}
+
+std::vector<TestDataType> parseDataTypeList(const std::string& str) {
+    std::vector<TestDataType> dataTypes;
+    for (const std::string& item : splitList(str, ',')) {
+        dataTypes.push_back(parseDataType(item));
+    }
+    return dataTypes;
+}
+
+std::vector<std::array<uint32_t, 4>> parseAllocationSizeList(const std::string& str) {
+    std::vector<std::array<uint32_t, 4>> allocationSizes;
+    for (const std::string& item : splitList(str, ',')) {
+        std::vector<std::string> dimensions = splitList(item, 'x');
+        if (dimensions.size() != 4) {
+            sgl::Logfile::get()->throwError(
+                    "Error in parseAllocationSizeList: Expected xs x ys x zs x cs, got \"" + item + "\".");
+        }
+        std::array<uint32_t, 4> allocationSize{};
+        for (size_t i = 0; i < 4; i++) {
+            allocationSize[i] = parseUint32(dimensions[i]);
+            // Empty buffers can't be allocated, and the index of the last entry would underflow.
+            if (allocationSize[i] == 0) {
+                sgl::Logfile::get()->throwError(
+                        "Error in parseAllocationSizeList: All dimensions must be at least 1, got "" + item + "".");
+            }
+        }
+        allocationSizes.push_back(allocationSize);
+    }
+    return allocationSizes;
+}
+
+void parseAllocationKind(const std::string& str, TestPlan& testPlan) {
+    if (str == "device" || str == "host" || str == "both") {
+        testPlan.useDeviceAllocation = str != "host";
+        testPlan.useHostAllocation = str != "device";
+    } else {
+        sgl::Logfile::get()->throwError("Error in parseAllocationKind: Unknown allocation kind \"" + str + "\".");
+    }
+}
+
+static void checkJsonType(bool isValid, const std::string& key) {
+    if (!isValid) {
+        sgl::Logfile::get()->throwError("Error in loadTestPlanMember: Invalid type of the value of \"" + key + "\".");
+    }
+}
+
+/// Joins the strings or non-negative integers of a JSON array into a list understood by the value parsers.
+static std::string getJsonListString(const sgl::JsonValue& value, const std::string& key) {
+    checkJsonType(value.isArray(), key);
+    std::string str;
+    for (size_t i = 0; i < value.size(); i++) {
+        const sgl::JsonValue& element = value[i];
+        if (element.isString()) {
+            str += element.asString() + ",";
+        } else {
+            checkJsonType(element.isUInt(), key);
+            str += std::to_string(element.asUInt()) + ",";
+        }
+    }
+    return str;
+}
+
+static void loadTestPlanMember(
+        const std::string& key, const sgl::JsonValue& value, TestPlan& testPlan, bool& benchmarkMode) {
+    if (key == "devices") {
+        testPlan.deviceIndices = parseDeviceIndexList(getJsonListString(value, key));
+    } else if (key == "modes") {
+        testPlan.testModes = parseTestModeList(getJsonListString(value, key));
+    } else if (key == "types") {
+        testPlan.dataTypes = parseDataTypeList(getJsonListString(value, key));
+    } else if (key == "sizes") {
+        checkJsonType(value.isArray(), key);
+        std::string sizesString;
+        for (size_t i = 0; i < value.size(); i++) {
+            std::string sizeString = getJsonListString(value[i], key);
+            std::replace(sizeString.begin(), sizeString.end(), ',', 'x');
+            sizesString += sizeString + ",";
+        }
+        testPlan.allocationSizes = parseAllocationSizeList(sizesString);
+    } else if (key == "allocation") {
+        checkJsonType(value.isString(), key);
+        parseAllocationKind(value.asString(), testPlan);
+    } else if (key == "repetitions") {
+        checkJsonType(value.isUInt(), key);
+        testPlan.numRepetitions = parseRepetitions(std::to_string(value.asUInt()));
+    } else if (key == "benchmark") {
+        checkJsonType(value.isBool(), key);
+        benchmarkMode = value.asBool();
+    } else {
+        sgl::Logfile::get()->throwError("Error in loadTestPlanMember: Unknown key \"" + key + "\".");
+    }
+}
+
+void loadTestPlanFile(const std::string& filePath, TestPlan& testPlan, bool& benchmarkMode) {
+    std::ifstream file(filePath);
+    if (!file.is_open()) {
+        sgl::Logfile::get()->throwError("Error in loadTestPlanFile: Could not open \"" + filePath + "\".");
+    }
+    std::stringstream sourceStream;
+    sourceStream << file.rdbuf();
+    sgl::JsonValue root;
+    try {
+        root = sgl::parseJson(sourceStream.str());
+    } catch (const std::exception& e) {
+        sgl::Logfile::get()->throwError("Error in loadTestPlanFile: " + filePath + ": " + e.what());
+    }
+    if (!root.isObject()) {
+        sgl::Logfile::get()->throwError("Error in loadTestPlanFile: " + filePath + ": Expected an object.");
+    }
+
+    for (const std::string& key : root.getMemberNames()) {
+        // The value parsers do not know about the file, so their errors are rethrown with the file and the key.
+        try {
+            loadTestPlanMember(key, root[key], testPlan, benchmarkMode);
+        } catch (const std::exception& e) {
+            sgl::Logfile::get()->throwError(
+                    "Error in loadTestPlanFile: " + filePath + ": \"" + key + "\": " + e.what());
+        }
+    }
+}
@@ -0,0 +1,83 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef BUFFERTEST64_TESTPLAN_HPP
+#define BUFFERTEST64_TESTPLAN_HPP
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include "TestTypes.hpp"
+
+/**
+ * Selects the test cases of the fixed-size tests. Empty lists select everything, i.e., all suitable devices, all test
+ * modes and data types supported by a device, and the default allocation sizes.
+ */
+struct TestPlan {
+    // Indices into the list of suitable devices.
+    std::vector<uint32_t> deviceIndices;
+    std::vector<TestMode> testModes;
+    std::vector<TestDataType> dataTypes;
+    // xs, ys, zs, cs of each allocation size in float entries.
+    std::vector<std::array<uint32_t, 4>> allocationSizes;
+    bool useDeviceAllocation = true;
+    bool useHostAllocation = true;
+    uint32_t numRepetitions = 1;
+
+    [[nodiscard]] bool getIsDeviceSelected(size_t deviceIdx) const;
+    [[nodiscard]] bool getIsTestModeSelected(TestMode testMode) const;
+    [[nodiscard]] bool getIsDataTypeSelected(TestDataType dataType) const;
+};
+
+/// Parses a decimal number in [0, 2^32 - 1]; throws on signs, other characters and overflow.
+uint32_t parseUint32(const std::string& str);
+
+/*
+ * Parsers for the values of the command line options, e.g., "0,1" for --devices, "storage-buffer,buffer-reference-64"
+ * for --modes, "float,uint8,vec4" for --types, "512x512x512x5,512x512x512x10" for --sizes and "device", "host" or "both"
+ * for --allocation. parseRepetitions parses a positive count for --repetitions. Throw on invalid values, including
+ * allocation sizes with a dimension of 0.
+ */
+uint32_t parseRepetitions(const std::string& str);
+std::vector<uint32_t> parseDeviceIndexList(const std::string& str);
+std::vector<TestMode> parseTestModeList(const std::string& str);
+std::vector<TestDataType> parseDataTypeList(const std::string& str);
+std::vector<std::array<uint32_t, 4>> parseAllocationSizeList(const std::string& str);
+void parseAllocationKind(const std::string& str, TestPlan& testPlan);
+
+/**
+ * Loads a test plan from a JSON file, e.g.:
+ * { "devices": [0], "modes": ["storage-buffer-64"], "types": ["float"], "sizes": [[512, 512, 512, 5]],
+ *   "allocation": "device", "repetitions": 3, "benchmark": true }
+ * All keys are optional. "benchmark" selects the benchmark instead of the correctness mode and is returned in
+ * benchmarkMode if present.
+ */
+void loadTestPlanFile(const std::string& filePath, TestPlan& testPlan, bool& benchmarkMode);
+
+#endif //BUFFERTEST64_TESTPLAN_HPP
@@ -0,0 +1,169 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef BUFFERTEST64_TESTTYPES_HPP
+#define BUFFERTEST64_TESTTYPES_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+enum class TestMode {
+    STORAGE_BUFFER = 0,
+    STORAGE_BUFFER_ARRAY = 1,
+    BUFFER_REFERENCE = 2,
+    BUFFER_REFERENCE_ARRAY = 3,
+    STORAGE_BUFFER_64_BIT = 4,
+    BUFFER_REFERENCE_64_BIT = 5,
+    BUFFER_REFERENCE_ARRAY_64_BIT = 6,
+};
+const int NUM_TESTS = 7;
+inline const char* const TEST_MODE_NAMES[] = {
+    "Storage buffer",
+    "Storage buffer array",
+    "Buffer reference",
+    "Buffer reference array",
+    "Storage buffer (64-bit)",
+    "Buffer reference (64-bit)",
+    "Buffer reference array (64-bit)",
+};
+// Identifiers used for selecting test modes in test plans.
+inline const char* const TEST_MODE_IDS[] = {
+    "storage-buffer",
+    "storage-buffer-array",
+    "buffer-reference",
+    "buffer-reference-array",
+    "storage-buffer-64",
+    "buffer-reference-64",
+    "buffer-reference-array-64",
+};
+inline const bool TEST_MODE_USES_ARRAY[] = {
+    false,
+    true,
+    false,
+    false,
+    false,
+    false,
+    false,
+};
+
+inline bool getTestModeUses64BitIndexing(TestMode testMode) {
+    return testMode == TestMode::STORAGE_BUFFER_64_BIT || testMode == TestMode::BUFFER_REFERENCE_64_BIT
+            || testMode == TestMode::BUFFER_REFERENCE_ARRAY_64_BIT;
+}
+
+enum class TestDataType {
+    FLOAT = 0,
+    UINT8 = 1,
+    FLOAT16 = 2,
+    UINT16 = 3,
+    UINT32 = 4,
+    UINT64 = 5,
+    VEC4 = 6,
+    F16VEC4 = 7,
+    UVEC4 = 8,
+};
+const int NUM_TEST_DATA_TYPES = 9;
+inline const char* const TEST_DATA_TYPE_NAMES[] = {
+    "float",
+    "uint8_t",
+    "float16_t",
+    "uint16_t",
+    "uint32_t",
+    "uint64_t",
+    "vec4",
+    "f16vec4",
+    "uvec4",
+};
+// Identifiers used for selecting data types in test plans.
+inline const char* const TEST_DATA_TYPE_IDS[] = {
+    "float",
+    "uint8",
+    "float16",
+    "uint16",
+    "uint32",
+    "uint64",
+    "vec4",
+    "f16vec4",
+    "uvec4",
+};
+// Size of one entry in bytes.
+inline const size_t TEST_DATA_TYPE_SIZES[] = {
+    4,
+    1,
+    2,
+    2,
+    4,
+    8,
+    16,
+    8,
+    16,
+};
+inline const uint32_t TEST_DATA_TYPE_NUM_COMPONENTS[] = {
+    1,
+    1,
+    1,
+    1,
+    1,
+    1,
+    4,
+    4,
+    4,
+};
+const size_t MAX_TEST_DATA_TYPE_SIZE = 16;
+
+inline size_t getTestDataTypeSize(TestDataType testDataType) {
+    return TEST_DATA_TYPE_SIZES[int(testDataType)];
+}
+
+enum class GatherPattern {
+    RANDOM = 0,
+    STRIDED = 1,
+    MORTON = 2,
+};
+const int NUM_GATHER_PATTERNS = 3;
+inline const char* const GATHER_PATTERN_NAMES[] = {
+    "uniform random",
+    "strided",
+    "Morton order",
+};
+
+enum class WriteOperation {
+    SCATTERED_STORE = 0,
+    ATOMIC_ADD = 1,
+    ATOMIC_MAX = 2,
+    ATOMIC_ADD_64 = 3,
+};
+const int NUM_WRITE_OPERATIONS = 4;
+inline const char* const WRITE_OPERATION_NAMES[] = {
+    "scattered store (uint32_t)",
+    "atomicAdd (uint32_t)",
+    "atomicMax (uint32_t)",
+    "atomicAdd (uint64_t)",
+};
+
+#endif //BUFFERTEST64_TESTTYPES_HPP
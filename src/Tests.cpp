@@ -27,362 +27,508 @@
  */
 
 #include <iostream>
+#include <algorithm>
+#include <chrono>
 #include <cstring>
 
 #include <Math/Math.hpp>
 #include <Utils/AppSettings.hpp>
-#include <Graphics/Vulkan/Utils/SyncObjects.hpp>
 #include <Graphics/Vulkan/Buffers/Buffer.hpp>
 #include <Graphics/Vulkan/Render/Renderer.hpp>
-#include <Graphics/Vulkan/Render/Passes/Pass.hpp>
 #include <ImGui/Widgets/NumberFormatting.hpp>
 
+#include "Timing.hpp"
+#include "ParallelFill.hpp"
+#include "FieldsBuffers.hpp"
+#include "GpuTimer.hpp"
+#include "ComputeQueueSubmitter.hpp"
+#include "ShaderCache.hpp"
+#include "BufferTestComputePass.hpp"
+#include "BufferBenchmarkComputePass.hpp"
+#include "Sweep.hpp"
+#include "HostImportBenchmark.hpp"
+#include "ArenaBenchmark.hpp"
+#include "GatherBenchmark.hpp"
+#include "WriteBenchmark.hpp"
+#include "DownloadBenchmark.hpp"
+#include "SparseBuffer.hpp"
+#include "SparseBenchmark.hpp"
+#include "PipelinedUpload.hpp"
+#include "VolumeFile.hpp"
+#include "ResultsWriter.hpp"
+#include "BufferPool.hpp"
+#include "PhaseStatistics.hpp"
+#include "MemoryBudget.hpp"
+#include "CpuReference.hpp"
 #include "Tests.hpp"
 
-#include "Graphics/Vulkan/Render/ComputePipeline.hpp"
-
-enum class TestMode {
-    STORAGE_BUFFER = 0,
-    STORAGE_BUFFER_ARRAY = 1,
-    BUFFER_REFERENCE = 2,
-    BUFFER_REFERENCE_ARRAY = 3,
-    STORAGE_BUFFER_64_BIT = 4,
-    BUFFER_REFERENCE_64_BIT = 5,
-    BUFFER_REFERENCE_ARRAY_64_BIT = 6,
-};
-const int NUM_TESTS = 7;
-const char* TEST_MODE_NAMES[] = {
-    "Storage buffer",
-    "Storage buffer array",
-    "Buffer reference",
-    "Buffer reference array",
-    "Storage buffer (64-bit)",
-    "Buffer reference (64-bit)",
-    "Buffer reference array (64-bit)",
-};
-bool TEST_MODE_USES_ARRAY[] = {
-    false,
-    true,
-    false,
-    false,
-    false,
-    false,
-    false,
-};
-
-enum class TestDataType {
-    FLOAT = 0,
-    UINT8 = 1,
-};
-const int NUM_TEST_DATA_TYPES = 2;
-const char* TEST_DATA_TYPE_NAMES[] = {
-    "float",
-    "uint8_t",
-};
-
-
-class BufferTestComputePass : public sgl::vk::ComputePass {
-public:
-    explicit BufferTestComputePass(sgl::vk::Renderer* renderer, uint32_t xs, uint32_t ys, uint32_t zs, uint32_t cs);
-    void setTestMode(TestMode _testMode);
-    void setDataType(TestDataType _dataType);
-    void setFieldsBuffer(const sgl::vk::BufferPtr& _fieldsBuffer);
-    void setFieldBuffers(const std::vector<sgl::vk::BufferPtr>& _fieldBuffers);
-    inline sgl::vk::BufferPtr getOutputBuffer() { return outputBuffer; }
-
-protected:
-    void loadShader() override;
-    void setComputePipelineInfo(sgl::vk::ComputePipelineInfo& pipelineInfo) override;
-    void createComputeData(sgl::vk::Renderer* renderer, sgl::vk::ComputePipelinePtr& computePipeline) override;
-    void _render() override;
-
-private:
-    uint32_t xs, ys, zs, cs;
-    sgl::vk::BufferPtr uniformBuffer;
-    sgl::vk::BufferPtr outputBuffer;
-    TestMode testMode = TestMode::STORAGE_BUFFER;
-    TestDataType dataType = TestDataType::FLOAT;
-    sgl::vk::BufferPtr fieldsBuffer;
-    std::vector<sgl::vk::BufferPtr> fieldBuffers;
-};
-
-BufferTestComputePass::BufferTestComputePass(
-        sgl::vk::Renderer* renderer, uint32_t xs, uint32_t ys, uint32_t zs, uint32_t cs)
-        : ComputePass(renderer), xs(xs), ys(ys), zs(zs), cs(cs) {
-    float data = 0.0f;
-    outputBuffer = std::make_shared<sgl::vk::Buffer>(
-            device, sizeof(float), &data,
-            VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
-            VMA_MEMORY_USAGE_GPU_ONLY);
-    uniformBuffer = std::make_shared<sgl::vk::Buffer>(
-            device, sizeof(uint64_t),
-            VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-            VMA_MEMORY_USAGE_GPU_ONLY);
-}
-
-void BufferTestComputePass::setTestMode(TestMode _testMode) {
-    testMode = _testMode;
-    setShaderDirty();
+static void addBufferPhaseSamples(
+        PhaseStatistics* phaseStatistics, const std::string& caseName, const FieldsBufferTimings& timings) {
+    phaseStatistics->addSample(caseName, TestPhase::ALLOCATION, timings.allocationSeconds);
+    phaseStatistics->addSample(caseName, TestPhase::FILL, timings.fillSeconds);
+    phaseStatistics->addSample(caseName, TestPhase::UPLOAD, timings.uploadSeconds);
 }
 
-void BufferTestComputePass::setDataType(TestDataType _dataType) {
-    dataType = _dataType;
-    setShaderDirty();
-}
-
-void BufferTestComputePass::setFieldsBuffer(const sgl::vk::BufferPtr& _fieldsBuffer) {
-    fieldsBuffer = _fieldsBuffer;
-    setDataDirty();
-}
-
-void BufferTestComputePass::setFieldBuffers(const std::vector<sgl::vk::BufferPtr>& _fieldBuffers) {
-    fieldBuffers = _fieldBuffers;
-    setDataDirty();
-}
-
-void BufferTestComputePass::loadShader() {
-    sgl::vk::ShaderManager->invalidateShaderCache();
-    std::map<std::string, std::string> preprocessorDefines;
-    preprocessorDefines.insert(std::make_pair("XS", std::to_string(xs)));
-    preprocessorDefines.insert(std::make_pair("YS", std::to_string(ys)));
-    preprocessorDefines.insert(std::make_pair("ZS", std::to_string(zs)));
-    preprocessorDefines.insert(std::make_pair("MEMBER_COUNT", std::to_string(cs)));
-    if (testMode == TestMode::STORAGE_BUFFER || testMode == TestMode::STORAGE_BUFFER_64_BIT) {
-        preprocessorDefines.insert(std::make_pair("INPUT_STORAGE_BUFFER", ""));
-    } else if (testMode == TestMode::STORAGE_BUFFER_ARRAY) {
-        preprocessorDefines.insert(std::make_pair("INPUT_STORAGE_BUFFER_ARRAY", ""));
-    } else if (testMode == TestMode::BUFFER_REFERENCE || testMode == TestMode::BUFFER_REFERENCE_64_BIT) {
-        preprocessorDefines.insert(std::make_pair("INPUT_BUFFER_REFERENCE", ""));
-    } else if (testMode == TestMode::BUFFER_REFERENCE_ARRAY || testMode == TestMode::BUFFER_REFERENCE_ARRAY_64_BIT) {
-        preprocessorDefines.insert(std::make_pair("INPUT_BUFFER_REFERENCE_ARRAY", ""));
-    }
-    std::vector<std::string> extensions;
-    if (testMode == TestMode::STORAGE_BUFFER_64_BIT || testMode == TestMode::BUFFER_REFERENCE_64_BIT
-            || testMode == TestMode::BUFFER_REFERENCE_ARRAY_64_BIT) {
-        // https://github.com/KhronosGroup/GLSL/blob/main/extensions/ext/GL_EXT_shader_64bit_indexing.txt
-        // https://github.khronos.org/SPIRV-Registry/extensions/EXT/SPV_EXT_shader_64bit_indexing.html
-        extensions.emplace_back("GL_EXT_shader_64bit_indexing");
-        preprocessorDefines.insert(std::make_pair("USE_64_BIT_INDEXING", ""));
+static void printBenchmarkResult(
+        std::ostream& out, const char* testModeName, size_t sizeInBytes, const std::vector<double>& elapsedTimes,
+        uint32_t numMismatches) {
+    out << "Benchmark '" << testModeName << "': " << (numMismatches == 0 ? "Passed" : "Failed");
+    out << " (" << numMismatches << " mismatches)";
+    if (elapsedTimes.empty()) {
+        out << ", GPU timestamps not supported" << std::endl;
+        return;
     }
-    if (dataType == TestDataType::FLOAT) {
-        preprocessorDefines.insert(std::make_pair("DATA_TYPE", "float"));
-        preprocessorDefines.insert(std::make_pair("DATA_TYPE_SIZE", "4"));
-    } else if (dataType == TestDataType::UINT8) {
-        preprocessorDefines.insert(std::make_pair("DATA_TYPE", "uint8_t"));
-        preprocessorDefines.insert(std::make_pair("DATA_TYPE_SIZE", "1"));
-        extensions.emplace_back("GL_EXT_shader_8bit_storage");
-        extensions.emplace_back("GL_EXT_shader_explicit_arithmetic_types_int8");
-    }
-    if (!extensions.empty()) {
-        std::string extensionsString;
-        for (size_t i = 0; i < extensions.size(); ++i) {
-            if (i != 0) {
-                extensionsString += ";";
-            }
-            extensionsString += extensions[i];
-        }
-        preprocessorDefines.insert(std::make_pair("__extensions", extensionsString));
-    }
-    shaderStages = sgl::vk::ShaderManager->getShaderStages({ "TestBuffer.Compute" }, preprocessorDefines);
-}
-
-void BufferTestComputePass::setComputePipelineInfo(sgl::vk::ComputePipelineInfo& pipelineInfo) {
-    if (testMode == TestMode::STORAGE_BUFFER_64_BIT || testMode == TestMode::BUFFER_REFERENCE_64_BIT
-            || testMode == TestMode::BUFFER_REFERENCE_ARRAY_64_BIT) {
-        // https://docs.vulkan.org/refpages/latest/refpages/source/VK_EXT_shader_64bit_indexing.html
-        pipelineInfo.setUse64BitIndexing(true);
+    double timeMin = elapsedTimes.front();
+    double timeSum = 0.0;
+    for (double elapsedTime : elapsedTimes) {
+        timeMin = std::min(timeMin, elapsedTime);
+        timeSum += elapsedTime;
     }
+    double timeAvg = timeSum / double(elapsedTimes.size());
+    out
+            << ", " << (timeAvg * 1e3) << "ms avg, " << (double(sizeInBytes) / timeAvg * 1e-9) << " GB/s avg, "
+            << (double(sizeInBytes) / timeMin * 1e-9) << " GB/s max" << std::endl;
 }
 
-void BufferTestComputePass::createComputeData(sgl::vk::Renderer* renderer, sgl::vk::ComputePipelinePtr& computePipeline) {
-    computeData = std::make_shared<sgl::vk::ComputeData>(renderer, computePipeline);
-    computeData->setStaticBuffer(outputBuffer, "OutputBuffer");
-    if (testMode == TestMode::STORAGE_BUFFER || testMode == TestMode::STORAGE_BUFFER_64_BIT) {
-        computeData->setStaticBuffer(fieldsBuffer, "InputBuffer");
-    } else if (testMode == TestMode::STORAGE_BUFFER_ARRAY) {
-        computeData->setStaticBufferArray(fieldBuffers, "InputBuffers");
-    } else if (testMode == TestMode::BUFFER_REFERENCE || testMode == TestMode::BUFFER_REFERENCE_64_BIT) {
-        computeData->setStaticBuffer(fieldsBuffer, "InputBuffer");
-    } else if (testMode == TestMode::BUFFER_REFERENCE_ARRAY || testMode == TestMode::BUFFER_REFERENCE_ARRAY_64_BIT) {
-        computeData->setStaticBuffer(uniformBuffer, "UniformBuffer");
+/// Adds the float result of a test mode for the cross-check of the CPU reference, which only models float fields.
+static void addGpuTestResult(
+        const TestContext& ctx, const std::array<uint32_t, 4>& allocSize, const TestRecord& record, double value) {
+    if (!ctx.gpuTestResults || record.testDataType != TestDataType::FLOAT) {
+        return;
     }
+    GpuTestResult result;
+    result.deviceName = ctx.device->getDeviceName();
+    result.allocSize = allocSize;
+    result.useHostAllocation = record.useHostAllocation;
+    result.testMode = record.testMode;
+    result.benchmarkMode = record.benchmarkMode;
+    result.value = value;
+    ctx.gpuTestResults->add(result);
 }
 
-void BufferTestComputePass::_render() {
-    if (testMode == TestMode::BUFFER_REFERENCE_ARRAY) {
-        uint64_t val = fieldsBuffer->getVkDeviceAddress();
-        uniformBuffer->updateData(sizeof(uint64_t), &val, renderer->getVkCommandBuffer());
-        renderer->insertBufferMemoryBarrier(
-                VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_UNIFORM_READ_BIT,
-                VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
-                uniformBuffer);
-        computeData->setStaticBuffer(uniformBuffer, "UniformBuffer");
-    }
-    renderer->dispatch(computeData, 1, 1, 1);
-}
-
-void runTest(uint32_t xs, uint32_t ys, uint32_t zs, uint32_t cs, TestDataType testDataType, bool useHostAllocation) {
-    sgl::vk::Device* device = sgl::AppSettings::get()->getPrimaryDevice();
-    std::cout << std::endl;
+/**
+ * Runs all applicable test modes for one allocation size and data type. All test passes are recorded into a single
+ * command buffer and write to their own slot of a shared output buffer, which is read back with a single map after
+ * waiting on a timeline semaphore.
+ */
+void runTest(
+        const TestSettings& testSettings, const TestContext& ctx, uint32_t xs, uint32_t ys, uint32_t zs, uint32_t cs,
+        TestDataType testDataType, bool useHostAllocation) {
+    sgl::vk::Device* device = ctx.device;
+    ShaderCache* shaderCache = ctx.shaderCache;
+    ctx.out << std::endl;
 
     size_t numEntries3D = size_t(xs) * size_t(ys) * size_t(zs);
     size_t numEntries = size_t(xs) * size_t(ys) * size_t(zs) * size_t(cs);
-    size_t sizeInBytes3D = sizeof(float) * numEntries3D;
     size_t sizeInBytes = sizeof(float) * numEntries;
-    if (testDataType == TestDataType::UINT8) {
-        cs *= 4;
-        numEntries *= 4;
+    // The allocation sizes are given in float entries. Smaller types get more members, larger types shorter rows.
+    const size_t dataTypeSize = getTestDataTypeSize(testDataType);
+    if (dataTypeSize < sizeof(float)) {
+        cs *= uint32_t(sizeof(float) / dataTypeSize);
+        numEntries *= sizeof(float) / dataTypeSize;
+    } else if (dataTypeSize > sizeof(float)) {
+        const auto entriesPerValue = uint32_t(dataTypeSize / sizeof(float));
+        if (xs % entriesPerValue != 0) {
+            ctx.out << "Skipping type " << TEST_DATA_TYPE_NAMES[int(testDataType)] << ", as the x size " << xs
+                    << " is not divisible by " << entriesPerValue << "." << std::endl;
+            return;
+        }
+        xs /= entriesPerValue;
+        numEntries /= entriesPerValue;
+        numEntries3D /= entriesPerValue;
     }
 
-    auto outputStagingBuffer = std::make_shared<sgl::vk::Buffer>(
-            device, sizeof(float),
-            VK_BUFFER_USAGE_TRANSFER_DST_BIT, VMA_MEMORY_USAGE_GPU_TO_CPU);
-
-    auto fence = std::make_shared<sgl::vk::Fence>(device);
-    sgl::vk::CommandPoolType commandPoolType{};
-    commandPoolType.queueFamilyIndex = device->getComputeQueueIndex();
-    commandPoolType.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
-    VkCommandPool commandPool{};
-    VkCommandBuffer commandBuffer = device->allocateCommandBuffer(commandPoolType, &commandPool);
-
-    std::cout << "Allocation size " << sgl::getNiceMemoryString(sizeInBytes, 2) << ", type " << TEST_DATA_TYPE_NAMES[int(testDataType)];
+    ctx.out << "Allocation size " << sgl::getNiceMemoryString(sizeInBytes, 2) << ", type " << TEST_DATA_TYPE_NAMES[int(testDataType)];
     if (useHostAllocation) {
-        std::cout << ", host allocation" << std::endl;
+        ctx.out << ", host allocation" << std::endl;
     } else {
-        std::cout << ", device allocation" << std::endl;
+        ctx.out << ", device allocation" << std::endl;
     }
 
-    auto* renderer = new sgl::vk::Renderer(device, 2000);
+    std::vector<TestMode> testModes;
+    bool usesFieldsBuffer = false;
+    bool usesFieldBuffers = false;
     for (int i = 0; i < NUM_TESTS; i++) {
-        if (testDataType == TestDataType::UINT8 && TEST_MODE_USES_ARRAY[i]) {
+        // The storage buffer array modes only support the float pattern.
+        if (testDataType != TestDataType::FLOAT && TEST_MODE_USES_ARRAY[i]) {
+            continue;
+        }
+        if (!testSettings.testPlan.getIsTestModeSelected(TestMode(i))) {
             continue;
         }
         if (!device->getShader64BitIndexingFeaturesEXT().shader64BitIndexing && i >= int(TestMode::STORAGE_BUFFER_64_BIT)) {
             break;
         }
-        std::cout << "Starting test case '" << TEST_MODE_NAMES[i] << "'..." << std::endl;
-        renderer->setCustomCommandBuffer(commandBuffer, false);
-        renderer->beginCommandBuffer();
-
-        auto testMode = TestMode(i);
-        auto pass0 = std::make_shared<BufferTestComputePass>(renderer, xs, ys, zs, cs);
-        pass0->setTestMode(testMode);
-        pass0->setDataType(testDataType);
-        if (TEST_MODE_USES_ARRAY[i]) {
-            auto* data = new float[numEntries3D];
-            memset(data, 0, sizeInBytes3D);
-            for (size_t i = 0; i < numEntries3D - 1; i++) {
-                data[i] = 7.0f;
+        testModes.push_back(TestMode(i));
+        usesFieldsBuffer = usesFieldsBuffer || !TEST_MODE_USES_ARRAY[i];
+        usesFieldBuffers = usesFieldBuffers || TEST_MODE_USES_ARRAY[i];
+    }
+
+    // The fields buffer(s) are only read, so all test modes can share them.
+    sgl::vk::BufferPtr fieldsBuffer;
+    std::vector<sgl::vk::BufferPtr> fieldBuffers;
+    // Test cases reading the same contents reuse them from the buffer pool; the pooled timings are not counted again.
+    FieldsBufferTimings fieldBuffersTimings{}, fieldsBufferTimings{};
+    BufferPool* bufferPool = ctx.bufferPool;
+    PhaseStatistics* phaseStatistics = ctx.phaseStatistics;
+    const std::string caseNamePrefix =
+            sgl::getNiceMemoryString(sizeInBytes, 2) + ", " + TEST_DATA_TYPE_NAMES[int(testDataType)]
+            + (useHostAllocation ? ", host" : ", device");
+    if (bufferPool) {
+        bufferPool->beginTestCase(sizeInBytes, testDataType, useHostAllocation);
+    }
+    if (usesFieldBuffers) {
+        BufferPoolKey key{ BufferContents::FIELD_BUFFERS, sizeInBytes, TestDataType::FLOAT, false };
+        if (bufferPool && bufferPool->find(key, fieldBuffers)) {
+            ctx.out << "Reusing pooled field buffers" << std::endl;
+        } else {
+            fieldBuffers = createFieldBuffers(testSettings, ctx, numEntries3D, cs, &fieldBuffersTimings);
+            if (bufferPool) {
+                bufferPool->insert(key, fieldBuffers, fieldBuffersTimings);
             }
-            sgl::vk::BufferPtr fieldBuffer0(new sgl::vk::Buffer(
-                    device, sizeInBytes3D, data,
-                    VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
-                    VMA_MEMORY_USAGE_GPU_ONLY));
-            data[numEntries3D - 1] = 42.0f;
-            sgl::vk::BufferPtr fieldBuffer1(new sgl::vk::Buffer(
-                    device, sizeInBytes3D, data,
-                    VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
-                    VMA_MEMORY_USAGE_GPU_ONLY));
-            delete[] data;
-            std::vector<sgl::vk::BufferPtr> fieldBuffers;
-            for (uint32_t j = 0; j < cs - 1; j++) {
-                fieldBuffers.push_back(fieldBuffer0);
+            if (phaseStatistics) {
+                addBufferPhaseSamples(phaseStatistics, caseNamePrefix + ", field buffers", fieldBuffersTimings);
             }
-            fieldBuffers.push_back(fieldBuffer1);
-            pass0->setFieldBuffers(fieldBuffers);
+        }
+    }
+    if (usesFieldsBuffer) {
+        BufferPoolKey key{ BufferContents::FIELDS, sizeInBytes, testDataType, useHostAllocation };
+        std::vector<sgl::vk::BufferPtr> pooledBuffers;
+        if (bufferPool && bufferPool->find(key, pooledBuffers)) {
+            ctx.out << "Reusing pooled fields buffer" << std::endl;
+            fieldsBuffer = pooledBuffers.front();
         } else {
-            sgl::vk::BufferPtr fieldsBuffer;
-            void* hostPtr = nullptr;
-            if (useHostAllocation) {
-                // Check claims from https://community.khronos.org/t/memory-import-size-truncated-on-windows/111813.
-                // https://docs.vulkan.org/refpages/latest/refpages/source/VK_EXT_external_memory_host.html
-                fieldsBuffer = std::make_shared<sgl::vk::Buffer>(device);
-                hostPtr = fieldsBuffer->allocateFromNewHostPointer(
-                        sizeInBytes, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT);
-            } else {
-                hostPtr = std::malloc(numEntries * sizeof(float));
+            fieldsBuffer = createFieldsBuffer(
+                    testSettings, ctx, testDataType, numEntries, sizeInBytes, useHostAllocation,
+                    nullptr, &fieldsBufferTimings);
+            if (bufferPool) {
+                bufferPool->insert(key, { fieldsBuffer }, fieldsBufferTimings);
             }
-            if (testDataType == TestDataType::FLOAT) {
-                auto* data = static_cast<float*>(hostPtr);
-                memset(data, 0, sizeInBytes);
-                for (size_t j = 0; j < numEntries - 1; j++) {
-                    data[j] = float(j);
-                }
-                data[numEntries - 1] = 42.0f;
-            } else if (testDataType == TestDataType::UINT8) {
-                auto* data = static_cast<uint8_t*>(hostPtr);
-                memset(data, 0, sizeInBytes);
-                for (size_t j = 0; j < numEntries - 1; j++) {
-                    data[j] = 7;
+            if (phaseStatistics) {
+                addBufferPhaseSamples(phaseStatistics, caseNamePrefix + ", fields buffer", fieldsBufferTimings);
+            }
+        }
+    }
+    if (ctx.memoryBudget) {
+        ctx.memoryBudget->sample();
+    }
+
+    // One slot per test mode. The output values of the test shader are tightly packed in the tested data type, and
+    // the benchmark shader writes a 32-bit mismatch count per slot.
+    const size_t outputBufferSize = NUM_TESTS * MAX_TEST_DATA_TYPE_SIZE;
+    auto outputBuffer = std::make_shared<sgl::vk::Buffer>(
+            device, outputBufferSize,
+            VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+            VMA_MEMORY_USAGE_GPU_ONLY);
+    auto outputStagingBuffer = std::make_shared<sgl::vk::Buffer>(
+            device, outputBufferSize,
+            VK_BUFFER_USAGE_TRANSFER_DST_BIT, VMA_MEMORY_USAGE_GPU_TO_CPU);
+
+    uint32_t numIterations = testSettings.benchmarkMode ? std::max(testSettings.benchmarkNumIterations, 1u) : 1u;
+    // One interval per dispatch and one for the readback of the output buffer.
+    GpuTimer gpuTimer(device, NUM_TESTS * numIterations + 1);
+    ComputeQueueSubmitter submitter(device);
+    sgl::vk::Renderer* renderer = submitter.getRenderer();
+    submitter.begin();
+
+    outputBuffer->fill(0, renderer->getVkCommandBuffer());
+    renderer->insertBufferMemoryBarrier(
+            VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+            VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            outputBuffer);
+    gpuTimer.reset(renderer->getVkCommandBuffer());
+
+    // The passes need to stay alive until the command buffer has finished executing.
+    std::vector<std::shared_ptr<BufferTestComputePass>> passes;
+    std::vector<std::vector<uint32_t>> intervalIndices(NUM_TESTS);
+    std::vector<double> shaderCompileTimes(NUM_TESTS, 0.0);
+    std::vector<double> originalShaderCompileTimes(NUM_TESTS, 0.0);
+    std::vector<bool> shaderCachedFlags(NUM_TESTS, false);
+    std::vector<double> pipelineCreationTimes(NUM_TESTS, 0.0);
+    for (TestMode testMode : testModes) {
+        auto i = int(testMode);
+        ctx.out << "Recording test case '" << TEST_MODE_NAMES[i] << "'..." << std::endl;
+        std::shared_ptr<BufferTestComputePass> pass;
+        if (testSettings.benchmarkMode) {
+            pass = std::make_shared<BufferBenchmarkComputePass>(
+                    renderer, shaderCache, xs, ys, zs, cs, testSettings.benchmarkWorkgroupSize);
+        } else {
+            pass = std::make_shared<BufferTestComputePass>(renderer, shaderCache, xs, ys, zs, cs);
+        }
+        pass->setTestMode(testMode);
+        pass->setDataType(testDataType);
+        pass->setOutputBuffer(outputBuffer, uint32_t(i));
+        if (TEST_MODE_USES_ARRAY[i]) {
+            pass->setFieldBuffers(fieldBuffers);
+        } else {
+            pass->setFieldsBuffer(fieldsBuffer);
+        }
+
+        // Builds the shader and pipeline outside of the recorded dispatches, so their CPU times can be separated.
+        double compileTimeStart = shaderCache->getCompileTimeSeconds();
+        double lookupCompileTimeStart = shaderCache->getLookupCompileTimeSeconds();
+        size_t numMissesStart = shaderCache->getNumMisses();
+        auto buildStartTime = std::chrono::steady_clock::now();
+        pass->buildIfNecessary();
+        double buildSeconds = getSecondsSince(buildStartTime);
+        shaderCompileTimes.at(i) = shaderCache->getCompileTimeSeconds() - compileTimeStart;
+        originalShaderCompileTimes.at(i) = shaderCache->getLookupCompileTimeSeconds() - lookupCompileTimeStart;
+        shaderCachedFlags.at(i) = shaderCache->getNumMisses() == numMissesStart;
+        pipelineCreationTimes.at(i) = std::max(buildSeconds - shaderCompileTimes.at(i), 0.0);
+        if (testSettings.benchmarkMode) {
+            for (uint32_t iteration = 0; iteration < numIterations; iteration++) {
+                // Serializes the dispatches, so they don't overlap in the timed intervals.
+                renderer->insertBufferMemoryBarrier(
+                        VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+                        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                        outputBuffer);
+                uint32_t intervalIdx = gpuTimer.begin(renderer->getVkCommandBuffer());
+                pass->render();
+                gpuTimer.end(renderer->getVkCommandBuffer(), intervalIdx);
+                intervalIndices.at(i).push_back(intervalIdx);
+            }
+        } else {
+            uint32_t intervalIdx = gpuTimer.begin(renderer->getVkCommandBuffer());
+            pass->render();
+            gpuTimer.end(renderer->getVkCommandBuffer(), intervalIdx);
+            intervalIndices.at(i).push_back(intervalIdx);
+        }
+        passes.push_back(pass);
+    }
+
+    renderer->insertBufferMemoryBarrier(
+            VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+            outputBuffer);
+    uint32_t readbackIntervalIdx = gpuTimer.begin(renderer->getVkCommandBuffer());
+    outputBuffer->copyDataTo(outputStagingBuffer, renderer->getVkCommandBuffer());
+    gpuTimer.end(renderer->getVkCommandBuffer(), readbackIntervalIdx);
+
+    submitter.submit();
+    auto waitStartTime = std::chrono::steady_clock::now();
+    submitter.wait();
+    double waitSeconds = getSecondsSince(waitStartTime);
+    if (ctx.memoryBudget) {
+        ctx.memoryBudget->sample();
+    }
+
+    std::vector<double> elapsedTimes = gpuTimer.getElapsedTimesSeconds();
+    std::vector<uint64_t> computeShaderInvocations = gpuTimer.getComputeShaderInvocations();
+    if (phaseStatistics) {
+        std::string caseName = caseNamePrefix + ", output buffer";
+        if (readbackIntervalIdx < elapsedTimes.size()) {
+            phaseStatistics->addSample(caseName, TestPhase::READBACK, elapsedTimes.at(readbackIntervalIdx));
+        }
+        phaseStatistics->addSample(caseName, TestPhase::WAIT, waitSeconds);
+    }
+    auto* outputData = static_cast<uint8_t*>(outputStagingBuffer->mapMemory());
+    for (TestMode testMode : testModes) {
+        auto i = int(testMode);
+        std::vector<double> elapsedTimesMode;
+        for (uint32_t intervalIdx : intervalIndices.at(i)) {
+            if (intervalIdx < elapsedTimes.size()) {
+                elapsedTimesMode.push_back(elapsedTimes.at(intervalIdx));
+            }
+        }
+
+        if (phaseStatistics) {
+            std::string caseName = caseNamePrefix + ", " + TEST_MODE_NAMES[i];
+            phaseStatistics->addSample(caseName, TestPhase::SHADER_COMPILE, shaderCompileTimes.at(i));
+            phaseStatistics->addSample(caseName, TestPhase::PIPELINE_CREATION, pipelineCreationTimes.at(i));
+            for (double elapsedTime : elapsedTimesMode) {
+                phaseStatistics->addSample(caseName, TestPhase::DISPATCH, elapsedTime);
+            }
+            for (uint32_t intervalIdx : intervalIndices.at(i)) {
+                if (intervalIdx < computeShaderInvocations.size()) {
+                    phaseStatistics->addComputeInvocations(caseName, computeShaderInvocations.at(intervalIdx));
                 }
-                data[numEntries - 1] = 42;
             }
-            if (!useHostAllocation) {
-                fieldsBuffer = std::make_shared<sgl::vk::Buffer>(
-                        device, sizeInBytes, hostPtr,
-                        VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
-                        VMA_MEMORY_USAGE_GPU_ONLY);
-                free(hostPtr);
+        }
+
+        TestRecord record{};
+        record.testMode = testMode;
+        record.testDataType = testDataType;
+        record.useHostAllocation = useHostAllocation;
+        record.sizeInBytes = sizeInBytes;
+        record.benchmarkMode = testSettings.benchmarkMode;
+        const FieldsBufferTimings& timings = TEST_MODE_USES_ARRAY[i] ? fieldBuffersTimings : fieldsBufferTimings;
+        record.allocationSeconds = timings.allocationSeconds;
+        record.fillSeconds = timings.fillSeconds;
+        record.uploadSeconds = timings.uploadSeconds;
+        record.shaderCompileSeconds = originalShaderCompileTimes.at(i);
+        record.shaderCached = shaderCachedFlags.at(i);
+        if (!elapsedTimesMode.empty()) {
+            double timeSum = 0.0;
+            for (double elapsedTime : elapsedTimesMode) {
+                timeSum += elapsedTime;
             }
-            pass0->setFieldsBuffer(fieldsBuffer);
+            record.dispatchSeconds = timeSum / double(elapsedTimesMode.size());
         }
-        auto outputBuffer = pass0->getOutputBuffer();
-        pass0->render();
-
-        renderer->insertBufferMemoryBarrier(
-                VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT,
-                VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
-                outputBuffer);
-        outputBuffer->copyDataTo(outputStagingBuffer, renderer->getVkCommandBuffer());
-
-        renderer->endCommandBuffer();
-        renderer->submitToQueue({}, {}, fence, VK_PIPELINE_STAGE_TRANSFER_BIT);
-        renderer->resetCustomCommandBuffer();
-        fence->wait();
-        fence->reset();
-
-        float outputValue = 0.0f;
-        if (testDataType == TestDataType::FLOAT) {
-            auto* outputValuePtr = static_cast<float*>(outputStagingBuffer->mapMemory());
-            outputValue = *outputValuePtr;
-        } else if (testDataType == TestDataType::UINT8) {
-            auto* outputValuePtr = static_cast<uint8_t*>(outputStagingBuffer->mapMemory());
-            outputValue = *outputValuePtr;
+        if (readbackIntervalIdx < elapsedTimes.size()) {
+            record.readbackSeconds = elapsedTimes.at(readbackIntervalIdx);
+        }
+
+        if (testSettings.benchmarkMode) {
+            auto numMismatches = reinterpret_cast<uint32_t*>(outputData)[i];
+            printBenchmarkResult(ctx.out, TEST_MODE_NAMES[i], sizeInBytes, elapsedTimesMode, numMismatches);
+            record.passed = numMismatches == 0;
+            record.value = double(numMismatches);
+            if (ctx.resultsWriter) {
+                ctx.resultsWriter->writeRecord(device, record);
+            }
+            addGpuTestResult(ctx, { xs, ys, zs, cs }, record, double(numMismatches) / double(numIterations));
+            continue;
         }
-        outputStagingBuffer->unmapMemory();
+
+        float outputValue = readDataTypeValue(testDataType, outputData + size_t(i) * dataTypeSize);
         std::string testResult;
         if (outputValue == 42) {
             testResult = "Passed";
         } else {
             testResult = "Failed";
         }
-        std::cout << "Test case '" << TEST_MODE_NAMES[i] << "': " << testResult << " (" << outputValue << ")" << std::endl;
+        ctx.out << "Test case '" << TEST_MODE_NAMES[i] << "': " << testResult << " (" << outputValue << ")" << std::endl;
+        record.passed = outputValue == 42;
+        record.value = double(outputValue);
+        if (ctx.resultsWriter) {
+            ctx.resultsWriter->writeRecord(device, record);
+        }
+        addGpuTestResult(ctx, { xs, ys, zs, cs }, record, record.value);
     }
+    outputStagingBuffer->unmapMemory();
 
-    device->freeCommandBuffer(commandPool, commandBuffer);
-    delete renderer;
+    passes.clear();
 }
 
-void runTests() {
-    sgl::vk::Device* device = sgl::AppSettings::get()->getPrimaryDevice();
-    std::cout << "Device name: " << device->getDeviceName() << std::endl;
+struct TestCase {
+    std::array<uint32_t, 4> allocSize;
+    TestDataType testDataType;
+    bool useHostAllocation;
+};
+
+/// Estimates the device-local and host memory of the buffers allocated by runTest for one test case.
+static MemoryRequirement estimateTestCaseMemory(const TestSettings& testSettings, const TestCase& testCase) {
+    const auto& allocSize = testCase.allocSize;
+    const size_t sizeInBytes3D = sizeof(float) * size_t(allocSize[0]) * size_t(allocSize[1]) * size_t(allocSize[2]);
+    const size_t sizeInBytes = sizeInBytes3D * size_t(allocSize[3]);
+    const size_t stagingSizeInBytes = testSettings.streamingChunkSizeInBytes * size_t(testSettings.numStreamingChunks);
+    MemoryRequirement requirement{};
+    if (testCase.useHostAllocation) {
+        requirement.hostSizeInBytes += sizeInBytes;
+    } else {
+        requirement.deviceSizeInBytes += sizeInBytes;
+        if (!testSettings.useGpuGeneration) {
+            requirement.hostSizeInBytes += testSettings.useStreamingUpload ? stagingSizeInBytes : sizeInBytes;
+        }
+    }
+    bool usesFieldBuffers = false;
+    for (int i = 0; i < NUM_TESTS; i++) {
+        usesFieldBuffers =
+                usesFieldBuffers || (TEST_MODE_USES_ARRAY[i] && testSettings.testPlan.getIsTestModeSelected(TestMode(i)));
+    }
+    if (usesFieldBuffers && testCase.testDataType == TestDataType::FLOAT) {
+        // The arena has one member per c, otherwise all but the last member share one buffer.
+        requirement.deviceSizeInBytes += testSettings.useBufferArena ? sizeInBytes : 2 * sizeInBytes3D;
+        requirement.hostSizeInBytes += testSettings.useBufferArena ? stagingSizeInBytes : sizeInBytes3D;
+    }
+    return requirement;
+}
+
+static std::string getTestCaseName(const TestCase& testCase) {
+    const auto& allocSize = testCase.allocSize;
+    return std::to_string(allocSize[0]) + "x" + std::to_string(allocSize[1]) + "x" + std::to_string(allocSize[2])
+            + "x" + std::to_string(allocSize[3]) + ", " + TEST_DATA_TYPE_NAMES[int(testCase.testDataType)]
+            + (testCase.useHostAllocation ? ", host allocation" : ", device allocation");
+}
+
+/**
+ * Runs the test cases whose memory fits into the current budget. A case that doesn't fit first releases the buffer
+ * pool, and is then deferred until all other cases have run, as the threads of other devices may have freed host
+ * memory by then. Cases still not fitting are skipped, so no bandwidth is measured while memory is paged out.
+ */
+static void runScheduledTestCases(
+        const TestSettings& testSettings, const TestContext& ctx, std::vector<TestCase> testCases) {
+    MemoryBudget* memoryBudget = ctx.memoryBudget;
+    for (int round = 0; round < 2 && !testCases.empty(); round++) {
+        std::vector<TestCase> deferredTestCases;
+        for (const TestCase& testCase : testCases) {
+            MemoryRequirement requirement = estimateTestCaseMemory(testSettings, testCase);
+            if (!memoryBudget->getFits(requirement) && ctx.bufferPool) {
+                ctx.bufferPool->clear();
+            }
+            if (!memoryBudget->getFits(requirement)) {
+                size_t hostAvailableBytes = MemoryBudget::getHostAvailableBytes();
+                ctx.out
+                        << std::endl << (round == 0 ? "Deferring" : "Skipping") << " test case "
+                        << getTestCaseName(testCase) << ": needs "
+                        << sgl::getNiceMemoryString(requirement.deviceSizeInBytes, 2) << " device-local and "
+                        << sgl::getNiceMemoryString(requirement.hostSizeInBytes, 2) << " host memory, "
+                        << sgl::getNiceMemoryString(memoryBudget->getDeviceAvailableBytes(), 2) << " and "
+                        << (hostAvailableBytes == SIZE_MAX
+                                ? std::string("unknown") : sgl::getNiceMemoryString(hostAvailableBytes, 2))
+                        << " available" << std::endl;
+                if (round == 0) {
+                    deferredTestCases.push_back(testCase);
+                }
+                continue;
+            }
+            const auto& allocSize = testCase.allocSize;
+            for (uint32_t repetition = 0; repetition < testSettings.testPlan.numRepetitions; repetition++) {
+                memoryBudget->beginCase();
+                runTest(
+                        testSettings, ctx, allocSize[0], allocSize[1], allocSize[2], allocSize[3],
+                        testCase.testDataType, testCase.useHostAllocation);
+                memoryBudget->printCaseSummary(ctx.out);
+            }
+        }
+        testCases = deferredTestCases;
+    }
+}
+
+bool getRunsFixedSizeTests(const TestSettings& testSettings) {
+    return !testSettings.sweepMode && !testSettings.hostImportBenchmarkMode && !testSettings.arenaBenchmarkMode
+            && !testSettings.gatherBenchmarkMode && !testSettings.writeBenchmarkMode
+            && !testSettings.downloadBenchmarkMode && !testSettings.sparseBenchmarkMode
+            && !testSettings.pipelinedUploadMode && testSettings.volumeFilePath.empty();
+}
+
+std::vector<std::array<uint32_t, 4>> getAllocationSizes(const TestPlan& testPlan, bool isCpuDevice) {
+    if (!testPlan.allocationSizes.empty()) {
+        return testPlan.allocationSizes;
+    }
+    if (isCpuDevice) {
+        return {
+                { 256, 256, 256, 5 }, // 320MiB
+                { 256, 256, 256, 10 }, // 640MiB
+        };
+    }
+    return {
+            { 512, 512, 512, 5 }, // 2.5GiB
+            { 512, 512, 512, 10 }, // 5GiB
+    };
+}
+
+void runTests(
+        const TestSettings& testSettings, sgl::vk::Device* device, std::ostream& out, ResultsWriter* resultsWriter,
+        GpuTestResults* gpuTestResults) {
+    out << "Device name: " << device->getDeviceName() << std::endl;
     if (device->getPhysicalDeviceProperties().apiVersion >= VK_API_VERSION_1_1) {
-        std::cout << "Device driver name: " << device->getDeviceDriverName() << std::endl;
-        std::cout << "Device driver info: " << device->getDeviceDriverInfo() << std::endl;
-        std::cout << "Device driver ID: " << device->getDeviceDriverId() << std::endl;
-        std::cout << "Device driver version: " << device->getDriverVersionString() << std::endl;
-        std::cout << "Device vendor ID: 0x" << sgl::toHexString(device->getPhysicalDeviceProperties().vendorID) << std::endl;
-        std::cout << "Device ID: 0x" << sgl::toHexString(device->getPhysicalDeviceProperties().deviceID) << std::endl;
+        out << "Device driver name: " << device->getDeviceDriverName() << std::endl;
+        out << "Device driver info: " << device->getDeviceDriverInfo() << std::endl;
+        out << "Device driver ID: " << device->getDeviceDriverId() << std::endl;
+        out << "Device driver version: " << device->getDriverVersionString() << std::endl;
+        out << "Device vendor ID: 0x" << sgl::toHexString(device->getPhysicalDeviceProperties().vendorID) << std::endl;
+        out << "Device ID: 0x" << sgl::toHexString(device->getPhysicalDeviceProperties().deviceID) << std::endl;
     }
-    std::cout << "Max memory allocations: "
+    out << "Max memory allocations: "
             << sgl::getNiceMemoryStringDifference(device->getLimits().maxMemoryAllocationCount, 2, true) << std::endl;
-    std::cout << "Max storage buffer range: "
+    out << "Max storage buffer range: "
             << sgl::getNiceMemoryStringDifference(device->getLimits().maxStorageBufferRange, 2, true) << std::endl;
-    std::cout << "Max memory allocation size: "
+    out << "Max memory allocation size: "
             << sgl::getNiceMemoryStringDifference(device->getPhysicalDeviceVulkan11Properties().maxMemoryAllocationSize, 2, true) << std::endl;
-    std::cout << "Supports shader 64-bit indexing: " << (device->getShader64BitIndexingFeaturesEXT().shader64BitIndexing ? "Yes" : "No") << std::endl;
-    std::cout << "alignof(std::max_align_t): " << alignof(std::max_align_t) << std::endl;
-    std::cout << "Min imported host pointer alignment: " << device->getMinImportedHostPointerAlignment() << std::endl;
+    out << "Supports shader 64-bit indexing: " << (device->getShader64BitIndexingFeaturesEXT().shader64BitIndexing ? "Yes" : "No") << std::endl;
+    out << "alignof(std::max_align_t): " << alignof(std::max_align_t) << std::endl;
+    out << "Min imported host pointer alignment: " << device->getMinImportedHostPointerAlignment() << std::endl;
 
     std::vector<std::string> flagsStringMap = {
             "device local",  // VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
@@ -421,32 +567,76 @@ void runTests() {
         if (hasTypeDeviceLocal != isHeapDeviceLocal) {
             sgl::Logfile::get()->writeError("Encountered memory heap with mismatching heap and type flags.");
         }
-        std::cout
+        out
                 << "Memory heap #" << heapIdx << ": "
                 << sgl::getNiceMemoryStringDifference(deviceMemoryProperties.memoryHeaps[heapIdx].size, 2, true)
                 << memoryHeapInfo << std::endl;
     }
+    if (testSettings.useSparseBinding && !SparseBuffer::getIsSupported(device)) {
+        out << "Sparse binding is not supported, using dedicated allocations." << std::endl;
+    }
 
-    std::vector<std::vector<uint32_t>> allocationSizes = {
-            { 512, 512, 512, 5 }, // 2.5GiB
-            { 512, 512, 512, 10 }, // 5GiB
-    };
-
-    for (const auto& allocSize : allocationSizes) {
-        for (int testDataTypeIdx = 0; testDataTypeIdx < NUM_TEST_DATA_TYPES; testDataTypeIdx++) {
-            auto testDataType = TestDataType(testDataTypeIdx);
-            if (testDataType == TestDataType::UINT8
-                    && !device->getPhysicalDeviceVulkan12Features().storageBuffer8BitAccess) {
-                continue;
-            }
-            for (int useHostAllocation = 0; useHostAllocation <= 1; useHostAllocation++) {
-                if (testDataType == TestDataType::UINT8 && useHostAllocation) {
+    const TestPlan& testPlan = testSettings.testPlan;
+    const bool isCpuDevice = device->getPhysicalDeviceProperties().deviceType == VK_PHYSICAL_DEVICE_TYPE_CPU;
+    if (isCpuDevice && testPlan.allocationSizes.empty()) {
+        out << "CPU device: Using scaled-down allocation sizes." << std::endl;
+    }
+    std::vector<std::array<uint32_t, 4>> allocationSizes = getAllocationSizes(testPlan, isCpuDevice);
+
+    ShaderCache shaderCache(device, testSettings.useShaderDiskCache);
+    BufferPool bufferPool;
+    PhaseStatistics phaseStatistics;
+    MemoryBudget memoryBudget(device);
+    TestContext ctx{
+            device, &shaderCache, out, resultsWriter, testSettings.useBufferPool ? &bufferPool : nullptr,
+            &phaseStatistics, &memoryBudget, gpuTestResults };
+    if (testSettings.sweepMode) {
+        runSweep(testSettings, ctx);
+    } else if (testSettings.hostImportBenchmarkMode) {
+        runHostImportBenchmark(testSettings, ctx);
+    } else if (testSettings.arenaBenchmarkMode) {
+        runArenaBenchmark(testSettings, ctx);
+    } else if (testSettings.gatherBenchmarkMode) {
+        runGatherBenchmark(testSettings, ctx);
+    } else if (testSettings.writeBenchmarkMode) {
+        runWriteBenchmark(testSettings, ctx);
+    } else if (testSettings.downloadBenchmarkMode) {
+        runDownloadBenchmark(testSettings, ctx);
+    } else if (testSettings.sparseBenchmarkMode) {
+        runSparseBenchmark(testSettings, ctx);
+    } else if (testSettings.pipelinedUploadMode) {
+        runPipelinedUploadBenchmark(testSettings, ctx);
+    } else if (!testSettings.volumeFilePath.empty()) {
+        runVolumeFileTest(testSettings, ctx);
+    } else {
+        std::vector<TestCase> testCases;
+        for (const auto& allocSize : allocationSizes) {
+            for (int testDataTypeIdx = 0; testDataTypeIdx < NUM_TEST_DATA_TYPES; testDataTypeIdx++) {
+                auto testDataType = TestDataType(testDataTypeIdx);
+                if (!testPlan.getIsDataTypeSelected(testDataType)) {
                     continue;
                 }
-                runTest(
-                        allocSize[0], allocSize[1], allocSize[2], allocSize[3],
-                        testDataType, bool(useHostAllocation));
+                if (!getIsTestDataTypeSupported(device, testDataType)) {
+                    continue;
+                }
+                for (int useHostAllocation = 0; useHostAllocation <= 1; useHostAllocation++) {
+                    if (testDataType == TestDataType::UINT8 && useHostAllocation) {
+                        continue;
+                    }
+                    if (useHostAllocation ? !testPlan.useHostAllocation : !testPlan.useDeviceAllocation) {
+                        continue;
+                    }
+                    testCases.push_back({ allocSize, testDataType, bool(useHostAllocation) });
+                }
             }
         }
+        runScheduledTestCases(testSettings, ctx, testCases);
+    }
+
+    out << std::endl;
+    shaderCache.printStatistics(out);
+    if (testSettings.useBufferPool) {
+        bufferPool.printStatistics(out);
     }
+    phaseStatistics.printSummary(out);
 }
@@ -29,6 +29,116 @@
 #ifndef BUFFERTEST64_TESTS_HPP
 #define BUFFERTEST64_TESTS_HPP
 
-void runTests();
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "TestTypes.hpp"
+#include "TestPlan.hpp"
+
+struct TestSettings {
+    // Devices, test modes, data types, allocation sizes and kinds to test.
+    TestPlan testPlan;
+    // Upload device allocations through a ring of small staging chunks instead of one full-size host copy.
+    bool useStreamingUpload = true;
+    // Write the pattern of device allocations on the GPU instead of filling it on the host and uploading it.
+    bool useGpuGeneration = true;
+    // Back device allocations with memory blocks bound to a sparse buffer instead of one dedicated allocation.
+    bool useSparseBinding = false;
+    size_t sparseBlockSizeInBytes = size_t(256) * size_t(1024) * size_t(1024);
+    size_t streamingChunkSizeInBytes = size_t(64) * size_t(1024) * size_t(1024);
+    uint32_t numStreamingChunks = 4;
+    // Stream the whole buffer through a grid-stride kernel per test mode and measure the read bandwidth.
+    bool benchmarkMode = false;
+    uint32_t benchmarkWorkgroupSize = 256;
+    uint32_t benchmarkNumIterations = 5;
+    // Search the largest correctly addressable buffer size per test mode instead of testing fixed sizes.
+    bool sweepMode = false;
+    size_t sweepMaxSizeInBytes = size_t(16) * size_t(1024) * size_t(1024) * size_t(1024);
+    // Compare zero-copy reads from imported host memory of different page types with a device-local copy.
+    bool hostImportBenchmarkMode = false;
+    size_t hostImportSizeInBytes = size_t(1024) * size_t(1024) * size_t(1024);
+    // Load the fields from a raw volume file with xs * ys * zs * cs entries instead of generating them.
+    std::string volumeFilePath;
+    uint32_t volumeXs = 0, volumeYs = 0, volumeZs = 0, volumeCs = 0;
+    TestDataType volumeDataType = TestDataType::FLOAT;
+    // Import the file mapping as host memory instead of streaming it to a device-local buffer.
+    bool volumeImportMapping = false;
+    // Use distinct storage buffer array members sub-allocated from a few memory blocks instead of one shared buffer.
+    bool useBufferArena = false;
+    // Upload the next case on a separate queue while the current case is read by a compute pass.
+    bool pipelinedUploadMode = false;
+    uint32_t pipelinedNumCases = 4;
+    size_t pipelinedCaseSizeInBytes = size_t(1024) * size_t(1024) * size_t(1024);
+    // Reuse filled fields buffers across test cases with the same allocation size and data type.
+    bool useBufferPool = true;
+    // Store compiled shaders and the pipeline cache on disk and reuse them in later runs.
+    bool useShaderDiskCache = true;
+    // Measure gathers per second of all test modes for cache-hostile index streams.
+    bool gatherBenchmarkMode = false;
+    // Measure the update throughput of scattered stores and atomics and verify the written entries.
+    bool writeBenchmarkMode = false;
+    // Stream a fields buffer back to the host through staging chunks in each host-visible memory type.
+    bool downloadBenchmarkMode = false;
+    // Compare the allocation time and read bandwidth of a sparse buffer with a single dedicated allocation.
+    bool sparseBenchmarkMode = false;
+    // Also test CPU Vulkan implementations (e.g., lavapipe), with scaled-down default allocation sizes.
+    bool allowCpuDevices = false;
+    // Run the access patterns of the test modes natively on the CPU after the tests of all devices.
+    bool useCpuReference = true;
+    // Compare buffer arena members with one allocation per member.
+    bool arenaBenchmarkMode = false;
+    uint32_t arenaNumMembers = 64;
+};
+
+namespace sgl { namespace vk {
+class Device;
+}}
+class ShaderCache;
+class ResultsWriter;
+class BufferPool;
+class PhaseStatistics;
+class MemoryBudget;
+class GpuTestResults;
+
+/**
+ * Per-device state of a test run. The test code only uses the device and output stream stored here and never the
+ * primary device of sgl::AppSettings.
+ */
+struct TestContext {
+    sgl::vk::Device* device;
+    ShaderCache* shaderCache;
+    std::ostream& out;
+    ResultsWriter* resultsWriter;
+    // Keeps fields buffers alive across test cases; null if disabled.
+    BufferPool* bufferPool;
+    // Collects the per-phase times of the fixed-size tests for the summary table; null if not needed.
+    PhaseStatistics* phaseStatistics;
+    // Tracks the peak device-local memory usage of the fixed-size tests; null if not needed.
+    MemoryBudget* memoryBudget;
+    // Collects the float results of the fixed-size tests for the cross-check of the CPU reference; null if not needed.
+    GpuTestResults* gpuTestResults;
+};
+
+/**
+ * Returns the allocation sizes of the test plan or, if it has none, the default sizes. The default sizes of CPU Vulkan
+ * implementations are scaled down, as they share the host memory with the test data and are much slower.
+ */
+std::vector<std::array<uint32_t, 4>> getAllocationSizes(const TestPlan& testPlan, bool isCpuDevice);
+
+/// Whether runTests runs the fixed-size test cases, i.e., none of the sweep, benchmark or volume file modes is set.
+bool getRunsFixedSizeTests(const TestSettings& testSettings);
+
+/**
+ * Runs all tests on the passed device and prints the log to out. If resultsWriter is not null, one record is written
+ * per test case and mode. If gpuTestResults is not null, the float results of the fixed-size tests are added to it.
+ * Both are thread-safe and may be shared by the threads of multiple devices.
+ */
+void runTests(
+        const TestSettings& testSettings, sgl::vk::Device* device, std::ostream& out,
+        ResultsWriter* resultsWriter = nullptr, GpuTestResults* gpuTestResults = nullptr);
 
 #endif //BUFFERTEST64_TESTS_HPP
@@ -0,0 +1,282 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <Graphics/Vulkan/Buffers/Buffer.hpp>
+#include <ImGui/Widgets/NumberFormatting.hpp>
+
+#include "Timing.hpp"
+#include "ParallelFill.hpp"
+#include "StreamingUpload.hpp"
+#include "HostMemory.hpp"
+#include "ReadBandwidthMeter.hpp"
+#include "BufferBenchmarkComputePass.hpp"
+#include "VolumeFile.hpp"
+
+MappedFile::MappedFile(const std::string& filePath, size_t mappingSizeInBytes, bool writable) {
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(
+            filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return;
+    }
+    fileHandle = file;
+    LARGE_INTEGER fileSize{};
+    if (!GetFileSizeEx(file, &fileSize)) {
+        return;
+    }
+    fileSizeInBytes = size_t(fileSize.QuadPart);
+    // Views of read-only files can't extend past the end of the file on Windows.
+    this->mappingSizeInBytes = fileSizeInBytes;
+    HANDLE mapping = CreateFileMappingA(
+            file, nullptr, writable ? PAGE_WRITECOPY : PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        return;
+    }
+    mappingHandle = mapping;
+    data = MapViewOfFile(mapping, writable ? FILE_MAP_COPY : FILE_MAP_READ, 0, 0, 0);
+#else
+    fd = open(filePath.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return;
+    }
+    struct stat fileStat{};
+    if (fstat(fd, &fileStat) != 0) {
+        return;
+    }
+    fileSizeInBytes = size_t(fileStat.st_size);
+    this->mappingSizeInBytes = std::max(mappingSizeInBytes, fileSizeInBytes);
+    // Accessing pages of a file mapping past the last page of the file raises SIGBUS. Thus, the whole range is
+    // reserved as anonymous zero pages first, and only the pages of the file are mapped over its beginning.
+    // Private writable mappings are copy-on-write, so the file itself is never modified.
+    const int protection = writable ? PROT_READ | PROT_WRITE : PROT_READ;
+    const auto pageSize = size_t(sysconf(_SC_PAGESIZE));
+    const size_t filePagesSizeInBytes = (fileSizeInBytes + pageSize - 1) / pageSize * pageSize;
+    void* mapping = mmap(
+            nullptr, this->mappingSizeInBytes, protection, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapping == MAP_FAILED) {
+        return;
+    }
+    if (filePagesSizeInBytes > 0 && mmap(
+            mapping, filePagesSizeInBytes, protection, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED) {
+        munmap(mapping, this->mappingSizeInBytes);
+        return;
+    }
+    data = mapping;
+#endif
+}
+
+MappedFile::~MappedFile() {
+#if defined(_WIN32)
+    if (data) {
+        UnmapViewOfFile(data);
+    }
+    if (mappingHandle) {
+        CloseHandle(mappingHandle);
+    }
+    if (fileHandle) {
+        CloseHandle(fileHandle);
+    }
+#else
+    if (data) {
+        munmap(const_cast<void*>(data), mappingSizeInBytes);
+    }
+    if (fd >= 0) {
+        close(fd);
+    }
+#endif
+}
+
+void MappedFile::evictFromPageCache() {
+#if defined(__linux__)
+    posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+#endif
+}
+
+void MappedFile::adviseSequential() {
+#if defined(__linux__)
+    madvise(const_cast<void*>(data), mappingSizeInBytes, MADV_SEQUENTIAL);
+#endif
+}
+
+void MappedFile::readahead(size_t byteOffset, size_t byteSize) {
+#if defined(__linux__)
+    const auto pageSize = size_t(sysconf(_SC_PAGESIZE));
+    size_t begin = byteOffset / pageSize * pageSize;
+    size_t end = std::min(byteOffset + byteSize, mappingSizeInBytes);
+    if (begin < end) {
+        madvise(static_cast<uint8_t*>(const_cast<void*>(data)) + begin, end - begin, MADV_WILLNEED);
+    }
+#else
+    (void)byteOffset;
+    (void)byteSize;
+#endif
+}
+
+void runVolumeFileTest(const TestSettings& testSettings, const TestContext& ctx) {
+    sgl::vk::Device* device = ctx.device;
+    const TestDataType testDataType = testSettings.volumeDataType;
+    const size_t dataTypeSize = getTestDataTypeSize(testDataType);
+    const size_t numEntries =
+            size_t(testSettings.volumeXs) * size_t(testSettings.volumeYs) * size_t(testSettings.volumeZs)
+            * size_t(testSettings.volumeCs);
+    const size_t sizeInBytes = numEntries * dataTypeSize;
+    ctx.out << std::endl;
+    if (numEntries == 0) {
+        ctx.out << "Volume file: The volume size needs to be set with --volume-size <xs> <ys> <zs> <cs>." << std::endl;
+        return;
+    }
+    bool importMapping = testSettings.volumeImportMapping;
+    if (importMapping && !device->isDeviceExtensionEnabled(VK_EXT_EXTERNAL_MEMORY_HOST_EXTENSION_NAME)) {
+        ctx.out << "Volume file: VK_EXT_external_memory_host is not supported." << std::endl;
+        return;
+    }
+
+    // Imported host memory needs to be a multiple of the minimum import alignment.
+    size_t importSizeInBytes = sizeInBytes;
+    if (importMapping) {
+        const size_t minAlignment = device->getMinImportedHostPointerAlignment();
+        importSizeInBytes = (sizeInBytes + minAlignment - 1) / minAlignment * minAlignment;
+    }
+    MappedFile mappedFile(testSettings.volumeFilePath, importSizeInBytes, importMapping);
+    if (!mappedFile.getIsValid()) {
+        ctx.out << "Volume file: Could not map '" << testSettings.volumeFilePath << "'." << std::endl;
+        return;
+    }
+    if (importMapping && mappedFile.getMappingSizeInBytes() < importSizeInBytes) {
+        // E.g., views of files on Windows can't extend past the end of the file.
+        ctx.out
+                << "Volume file: The mapping can't be padded to the import alignment; streaming it instead."
+                << std::endl;
+        importMapping = false;
+    }
+    if (mappedFile.getFileSizeInBytes() < sizeInBytes) {
+        ctx.out
+                << "Volume file: '" << testSettings.volumeFilePath << "' has "
+                << mappedFile.getFileSizeInBytes() << " bytes, but the volume needs " << sizeInBytes << "."
+                << std::endl;
+        return;
+    }
+    ctx.out
+            << "Volume file '" << testSettings.volumeFilePath << "': " << sgl::getNiceMemoryString(sizeInBytes, 2)
+            << ", type " << TEST_DATA_TYPE_NAMES[int(testDataType)]
+            << (importMapping ? ", imported mapping" : ", streamed to device") << std::endl;
+    // Measure the throughput from disk and not from the page cache filled by previous runs.
+    mappedFile.evictFromPageCache();
+
+    ReadBandwidthMeter meter(device, 1);
+    auto testPass = std::make_shared<BufferTestComputePass>(
+            meter.getRenderer(), ctx.shaderCache, testSettings.volumeXs, testSettings.volumeYs,
+            testSettings.volumeZs, testSettings.volumeCs);
+    testPass->setTestMode(TestMode::BUFFER_REFERENCE_ARRAY);
+    testPass->setDataType(testDataType);
+    testPass->setOutputBuffer(meter.getOutputBuffer(), 0);
+
+    sgl::vk::BufferPtr deviceBuffer;
+    std::unique_ptr<HostImportedBuffer> importedBuffer;
+    double diskToGpuSeconds = 0.0;
+    auto startTime = std::chrono::steady_clock::now();
+    if (importMapping) {
+        try {
+            importedBuffer = std::make_unique<HostImportedBuffer>(
+                    device, const_cast<void*>(mappedFile.getData()), importSizeInBytes);
+        } catch (const std::exception& e) {
+            ctx.out << "Volume file: Importing the mapping failed: " << e.what() << std::endl;
+            return;
+        }
+        double importSeconds = getSecondsSince(startTime);
+        // Depending on the driver, the import pins (and thus reads) all pages or they are faulted in on first access,
+        // so the disk-to-GPU time includes one full read of the volume.
+        auto benchmarkPass = std::make_shared<BufferBenchmarkComputePass>(
+                meter.getRenderer(), ctx.shaderCache, testSettings.volumeXs, testSettings.volumeYs,
+                testSettings.volumeZs, testSettings.volumeCs, testSettings.benchmarkWorkgroupSize);
+        benchmarkPass->setTestMode(TestMode::BUFFER_REFERENCE_ARRAY);
+        benchmarkPass->setDataType(testDataType);
+        benchmarkPass->setOutputBuffer(meter.getOutputBuffer(), 0);
+        benchmarkPass->setFieldsDeviceAddress(importedBuffer->getVkDeviceAddress());
+        ReadMeasurement firstRead = meter.measure(benchmarkPass.get());
+        diskToGpuSeconds = getSecondsSince(startTime);
+        ctx.out << "Import: " << (importSeconds * 1e3) << "ms";
+        if (firstRead.readSeconds > 0.0) {
+            ctx.out << ", first GPU read: " << (firstRead.readSeconds * 1e3) << "ms";
+        }
+        ctx.out << std::endl;
+        testPass->setFieldsDeviceAddress(importedBuffer->getVkDeviceAddress());
+    } else {
+        deviceBuffer = std::make_shared<sgl::vk::Buffer>(
+                device, sizeInBytes,
+                VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT
+                | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+                VMA_MEMORY_USAGE_GPU_ONLY);
+        // Keep the kernel reading ahead of the producer thread by the size of the staging ring.
+        const size_t readaheadSize = testSettings.streamingChunkSizeInBytes * testSettings.numStreamingChunks;
+        mappedFile.adviseSequential();
+        mappedFile.readahead(0, readaheadSize);
+        const auto* fileData = static_cast<const uint8_t*>(mappedFile.getData());
+        StreamingUploader streamingUploader(
+                device, testSettings.streamingChunkSizeInBytes, testSettings.numStreamingChunks);
+        UploadStatistics uploadStatistics = streamingUploader.upload(
+                deviceBuffer, [&](void* dst, size_t byteOffset, size_t byteSize) {
+            mappedFile.readahead(byteOffset + readaheadSize, byteSize);
+            // Copying with all cores keeps multiple page faults (and thus disk reads) in flight.
+            auto* dstBytes = static_cast<uint8_t*>(dst);
+            parallelFill(byteSize, 1, [&](size_t begin, size_t end) {
+                std::memcpy(dstBytes + begin, fileData + byteOffset + begin, end - begin);
+            });
+        });
+        diskToGpuSeconds = getSecondsSince(startTime);
+        printUploadStatistics(ctx.out, uploadStatistics);
+        testPass->setFieldsBuffer(deviceBuffer);
+    }
+    ctx.out
+            << "Disk to GPU: " << (diskToGpuSeconds * 1e3) << "ms ("
+            << (double(sizeInBytes) / diskToGpuSeconds * 1e-9) << " GB/s)" << std::endl;
+
+    // Check that the last entry arrived on the GPU unchanged.
+    ReadMeasurement lastEntryRead = meter.measure(testPass.get());
+    uint32_t expectedWord = 0;
+    std::memcpy(
+            &expectedWord, static_cast<const uint8_t*>(mappedFile.getData()) + sizeInBytes - dataTypeSize,
+            dataTypeSize);
+    bool passed = lastEntryRead.outputWord == expectedWord;
+    ctx.out << "Last entry check: " << (passed ? "Passed" : "Failed") << std::endl;
+}
@@ -0,0 +1,85 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef BUFFERTEST64_VOLUMEFILE_HPP
+#define BUFFERTEST64_VOLUMEFILE_HPP
+
+#include <cstddef>
+#include <string>
+
+#include "Tests.hpp"
+
+/**
+ * Read-only memory mapping of a whole file. On Linux, the access pattern can be advised to the kernel, so sequential
+ * reads trigger a larger readahead.
+ */
+class MappedFile {
+public:
+    /**
+     * Maps the file with at least mappingSizeInBytes bytes (0 for the file size). On POSIX systems, the bytes past the
+     * last page of the file are anonymous zero pages. On Windows, the mapping can't extend past the end of the file.
+     * Writable mappings are private copy-on-write mappings, as some drivers can only import host memory that is
+     * writable.
+     */
+    explicit MappedFile(const std::string& filePath, size_t mappingSizeInBytes = 0, bool writable = false);
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    [[nodiscard]] inline bool getIsValid() const { return data != nullptr; }
+    [[nodiscard]] inline const void* getData() const { return data; }
+    [[nodiscard]] inline size_t getFileSizeInBytes() const { return fileSizeInBytes; }
+    [[nodiscard]] inline size_t getMappingSizeInBytes() const { return mappingSizeInBytes; }
+
+    /// Drops the clean pages of the file from the page cache, so the next access reads from disk (Linux only).
+    void evictFromPageCache();
+    /// Advises sequential access (MADV_SEQUENTIAL) for the whole mapping (Linux only).
+    void adviseSequential();
+    /// Starts asynchronous readahead of the passed byte range (MADV_WILLNEED; Linux only).
+    void readahead(size_t byteOffset, size_t byteSize);
+
+private:
+    const void* data = nullptr;
+    size_t fileSizeInBytes = 0;
+    size_t mappingSizeInBytes = 0;
+#if defined(_WIN32)
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#else
+    int fd = -1;
+#endif
+};
+
+/**
+ * Loads the raw volume file set in the test settings (xs * ys * zs * cs entries of the volume data type) into a GPU
+ * buffer and prints the disk-to-GPU throughput. The mapping of the file is either imported directly as host memory or
+ * streamed to a device-local buffer in chunks. Afterwards, the last entry is read on the GPU and compared to the file.
+ */
+void runVolumeFileTest(const TestSettings& testSettings, const TestContext& ctx);
+
+#endif //BUFFERTEST64_VOLUMEFILE_HPP
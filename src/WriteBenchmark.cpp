@@ -0,0 +1,206 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <iomanip>
+#include <algorithm>
+
+#include <Graphics/Vulkan/Utils/Device.hpp>
+#include <Graphics/Vulkan/Buffers/Buffer.hpp>
+#include <Graphics/Vulkan/Render/Renderer.hpp>
+#include <ImGui/Widgets/NumberFormatting.hpp>
+
+#include "GpuTimer.hpp"
+#include "ComputeQueueSubmitter.hpp"
+#include "BufferWriteComputePass.hpp"
+#include "WriteBenchmark.hpp"
+
+static const uint32_t WRITE_XS = 512;
+static const uint32_t WRITE_YS = 512;
+static const uint32_t WRITE_ZS = 512;
+// Two thirds of the entries lie above the 4GiB boundary.
+static const size_t WRITE_SIZE_IN_BYTES = size_t(6) * size_t(1024) * size_t(1024) * size_t(1024);
+
+struct WriteMeasurement {
+    double updateSeconds = 0.0; ///< Average time of one update dispatch.
+    uint32_t numMismatches = 0;
+};
+
+/**
+ * Clears the fields buffer, runs numIterations timed update dispatches and one verification dispatch in a single
+ * command buffer and waits for the results.
+ */
+static WriteMeasurement measureWrites(
+        sgl::vk::Device* device, ComputeQueueSubmitter& submitter, const sgl::vk::BufferPtr& fieldsBuffer,
+        const sgl::vk::BufferPtr& outputBuffer, const sgl::vk::BufferPtr& outputStagingBuffer,
+        BufferWriteComputePass* updatePass, BufferWriteComputePass* verifyPass, uint32_t numIterations) {
+    sgl::vk::Renderer* renderer = submitter.getRenderer();
+    VkCommandBuffer commandBuffer = submitter.getVkCommandBuffer();
+    GpuTimer gpuTimer(device, numIterations);
+
+    submitter.begin();
+    vkCmdFillBuffer(commandBuffer, fieldsBuffer->getVkBuffer(), 0, VK_WHOLE_SIZE, 0);
+    outputBuffer->fill(0, commandBuffer);
+    gpuTimer.reset(commandBuffer);
+    for (uint32_t iteration = 0; iteration < numIterations; iteration++) {
+        // Also orders the atomics of consecutive iterations, so each dispatch is timed on its own.
+        renderer->insertBufferMemoryBarrier(
+                VK_ACCESS_TRANSFER_WRITE_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+                VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+                VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                fieldsBuffer);
+        uint32_t intervalIdx = gpuTimer.begin(commandBuffer);
+        updatePass->render();
+        gpuTimer.end(commandBuffer, intervalIdx);
+    }
+    renderer->insertBufferMemoryBarrier(
+            VK_ACCESS_TRANSFER_WRITE_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+            VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+            VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            fieldsBuffer);
+    renderer->insertBufferMemoryBarrier(
+            VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+            VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            outputBuffer);
+    verifyPass->render();
+    renderer->insertBufferMemoryBarrier(
+            VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+            outputBuffer);
+    outputBuffer->copyDataTo(outputStagingBuffer, commandBuffer);
+    submitter.submitAndWait();
+
+    WriteMeasurement measurement{};
+    std::vector<double> elapsedTimes = gpuTimer.getElapsedTimesSeconds();
+    if (!elapsedTimes.empty()) {
+        double timeSum = 0.0;
+        for (double elapsedTime : elapsedTimes) {
+            timeSum += elapsedTime;
+        }
+        measurement.updateSeconds = timeSum / double(elapsedTimes.size());
+    }
+    measurement.numMismatches = static_cast<uint32_t*>(outputStagingBuffer->mapMemory())[0];
+    outputStagingBuffer->unmapMemory();
+    return measurement;
+}
+
+void runWriteBenchmark(const TestSettings& testSettings, const TestContext& ctx) {
+    sgl::vk::Device* device = ctx.device;
+    std::vector<TestMode> testModes;
+    for (int i = 0; i < NUM_TESTS; i++) {
+        if (!device->getShader64BitIndexingFeaturesEXT().shader64BitIndexing
+                && i >= int(TestMode::STORAGE_BUFFER_64_BIT)) {
+            break;
+        }
+        if (!TEST_MODE_USES_ARRAY[i] && testSettings.testPlan.getIsTestModeSelected(TestMode(i))) {
+            testModes.push_back(TestMode(i));
+        }
+    }
+
+    const uint32_t numIterations = std::max(testSettings.benchmarkNumIterations, 1u);
+    // All passes record into the command buffer of the submitter, so they are created with its renderer.
+    ComputeQueueSubmitter submitter(device);
+    sgl::vk::Renderer* renderer = submitter.getRenderer();
+    auto outputBuffer = std::make_shared<sgl::vk::Buffer>(
+            device, sizeof(uint32_t),
+            VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+            VMA_MEMORY_USAGE_GPU_ONLY);
+    auto outputStagingBuffer = std::make_shared<sgl::vk::Buffer>(
+            device, sizeof(uint32_t), VK_BUFFER_USAGE_TRANSFER_DST_BIT, VMA_MEMORY_USAGE_GPU_TO_CPU);
+
+    for (int operationIdx = 0; operationIdx < NUM_WRITE_OPERATIONS; operationIdx++) {
+        auto writeOperation = WriteOperation(operationIdx);
+        ctx.out << std::endl;
+        ctx.out
+                << "Write benchmark: " << WRITE_OPERATION_NAMES[operationIdx] << ", "
+                << sgl::getNiceMemoryString(WRITE_SIZE_IN_BYTES, 2) << std::endl;
+        if (writeOperation == WriteOperation::ATOMIC_ADD_64
+                && !device->getPhysicalDeviceVulkan12Features().shaderBufferInt64Atomics) {
+            ctx.out << "64-bit buffer atomics are not supported." << std::endl;
+            continue;
+        }
+        const size_t entrySize = writeOperation == WriteOperation::ATOMIC_ADD_64 ? sizeof(uint64_t) : sizeof(uint32_t);
+        const size_t numEntries3D = size_t(WRITE_XS) * size_t(WRITE_YS) * size_t(WRITE_ZS);
+        const auto cs = uint32_t(WRITE_SIZE_IN_BYTES / (numEntries3D * entrySize));
+        const size_t numEntries = numEntries3D * size_t(cs);
+
+        sgl::vk::BufferPtr fieldsBuffer;
+        try {
+            fieldsBuffer = std::make_shared<sgl::vk::Buffer>(
+                    device, numEntries * entrySize,
+                    VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT
+                    | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+                    VMA_MEMORY_USAGE_GPU_ONLY);
+        } catch (const std::exception& e) {
+            ctx.out << "Allocation failed: " << e.what() << std::endl;
+            continue;
+        }
+
+        ctx.out
+                << std::left << std::setw(34) << "Test mode" << std::right << std::setw(12) << "Time [ms]"
+                << std::setw(14) << "Gupdates/s" << std::setw(12) << "Mismatches" << std::endl;
+        for (TestMode testMode : testModes) {
+            // Separate passes, as the verification uses another shader and both are recorded in one command buffer.
+            std::shared_ptr<BufferWriteComputePass> passes[2];
+            for (int passIdx = 0; passIdx < 2; passIdx++) {
+                passes[passIdx] = std::make_shared<BufferWriteComputePass>(
+                        renderer, ctx.shaderCache, WRITE_XS, WRITE_YS, WRITE_ZS, cs,
+                        testSettings.benchmarkWorkgroupSize);
+                passes[passIdx]->setTestMode(testMode);
+                passes[passIdx]->setWriteOperation(writeOperation);
+                passes[passIdx]->setVerify(passIdx == 1, numIterations);
+                passes[passIdx]->setFieldsBuffer(fieldsBuffer);
+                passes[passIdx]->setOutputBuffer(outputBuffer, 0);
+            }
+            ctx.out << std::left << std::setw(34) << TEST_MODE_NAMES[int(testMode)] << std::right;
+            // Builds the pipelines before the command buffer is begun, so a shader that fails to compile only fails
+            // its row and leaves the submitter usable.
+            try {
+                passes[0]->buildIfNecessary();
+                passes[1]->buildIfNecessary();
+            } catch (const std::exception& e) {
+                ctx.out << " Shader or pipeline creation failed: " << e.what() << std::endl;
+                continue;
+            }
+            WriteMeasurement measurement = measureWrites(
+                    device, submitter, fieldsBuffer, outputBuffer, outputStagingBuffer,
+                    passes[0].get(), passes[1].get(), numIterations);
+
+            ctx.out << std::fixed << std::setprecision(2);
+            if (measurement.updateSeconds > 0.0) {
+                ctx.out << std::setw(12) << (measurement.updateSeconds * 1e3);
+                ctx.out << std::setw(14) << (double(numEntries) / measurement.updateSeconds * 1e-9);
+            } else {
+                ctx.out << std::setw(12) << "-" << std::setw(14) << "-";
+            }
+            ctx.out << std::setw(12) << measurement.numMismatches << std::endl;
+            ctx.out.unsetf(std::ios_base::floatfield);
+            ctx.out << std::setprecision(6);
+        }
+    }
+}